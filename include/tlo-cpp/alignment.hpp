@@ -0,0 +1,211 @@
+#ifndef TLO_CPP_ALIGNMENT_HPP
+#define TLO_CPP_ALIGNMENT_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#include "tlo-cpp/lcs.hpp"
+#include "tlo-cpp/levenshtein.hpp"
+
+namespace tlo {
+// Operations that transform sequence1 into sequence2. MATCH and SUBSTITUTION
+// consume one element of each sequence, DELETION consumes one element of
+// sequence1, and INSERTION consumes one element of sequence2.
+enum class EditOperation { MATCH, SUBSTITUTION, INSERTION, DELETION };
+
+// length consecutive occurrences of operation.
+struct EditRun {
+  EditOperation operation;
+  std::size_t length;
+};
+
+std::ostream &operator<<(std::ostream &os, EditOperation operation);
+std::ostream &operator<<(std::ostream &os, const EditRun &run);
+bool operator==(const EditRun &run1, const EditRun &run2);
+
+// Writes a sequence of runs as {run1, run2, ...}.
+std::ostream &operator<<(std::ostream &os, const std::vector<EditRun> &runs);
+
+namespace internal {
+// Appends length occurrences of operation to runs, extending the last run if
+// it has the same operation. Does nothing if length is 0.
+void appendEditRun(std::vector<EditRun> &runs, EditOperation operation,
+                   std::size_t length);
+
+// Appends to runs an alignment of sequence1[startIndex1, startIndex1+size1)
+// and sequence2[startIndex2, startIndex2+size2) for which IS_LCS selects the
+// cost: Levenshtein distance if false, LCS distance if true. Splits
+// sequence1 in half, finds where an optimal alignment crosses the split using
+// a forward last row of the first half and a backward last row of the second
+// half, then recurses on both sides (Hirschberg's algorithm). forwardRow and
+// backwardRow are scratch buffers, only used before recursing.
+template <bool IS_LCS, class CharSequence>
+void hirschberg(const CharSequence &sequence1, std::size_t startIndex1,
+                std::size_t size1, const CharSequence &sequence2,
+                std::size_t startIndex2, std::size_t size2,
+                std::vector<EditRun> &runs,
+                std::vector<std::size_t> &forwardRow,
+                std::vector<std::size_t> &backwardRow) {
+  if (size1 == 0 || size2 == 0) {
+    appendEditRun(runs, EditOperation::DELETION, size1);
+    appendEditRun(runs, EditOperation::INSERTION, size2);
+    return;
+  }
+
+  if (size1 == 1) {
+    std::size_t j = 0;
+
+    while (j < size2 && sequence1[startIndex1] != sequence2[startIndex2 + j]) {
+      ++j;
+    }
+
+    if (j < size2) {
+      appendEditRun(runs, EditOperation::INSERTION, j);
+      appendEditRun(runs, EditOperation::MATCH, 1);
+      appendEditRun(runs, EditOperation::INSERTION, size2 - j - 1);
+    } else if constexpr (IS_LCS) {
+      appendEditRun(runs, EditOperation::DELETION, 1);
+      appendEditRun(runs, EditOperation::INSERTION, size2);
+    } else {
+      appendEditRun(runs, EditOperation::SUBSTITUTION, 1);
+      appendEditRun(runs, EditOperation::INSERTION, size2 - 1);
+    }
+
+    return;
+  }
+
+  const std::size_t half = size1 / 2;
+  std::size_t split = 0;
+
+  if constexpr (IS_LCS) {
+    lcsLastRow<false>(sequence1, startIndex1, half, sequence2, startIndex2,
+                      size2, forwardRow);
+    lcsLastRow<true>(sequence1, startIndex1 + half, size1 - half, sequence2,
+                     startIndex2, size2, backwardRow);
+
+    std::size_t bestLength = 0;
+
+    for (std::size_t col = 0; col <= size2; ++col) {
+      std::size_t length = forwardRow[col] + backwardRow[size2 - col];
+
+      if (length > bestLength) {
+        bestLength = length;
+        split = col;
+      }
+    }
+  } else {
+    levenshteinLastRow<false>(sequence1, startIndex1, half, sequence2,
+                              startIndex2, size2, forwardRow);
+    levenshteinLastRow<true>(sequence1, startIndex1 + half, size1 - half,
+                             sequence2, startIndex2, size2, backwardRow);
+
+    std::size_t bestDistance = forwardRow[0] + backwardRow[size2];
+
+    for (std::size_t col = 1; col <= size2; ++col) {
+      std::size_t distance = forwardRow[col] + backwardRow[size2 - col];
+
+      if (distance < bestDistance) {
+        bestDistance = distance;
+        split = col;
+      }
+    }
+  }
+
+  hirschberg<IS_LCS>(sequence1, startIndex1, half, sequence2, startIndex2,
+                     split, runs, forwardRow, backwardRow);
+  hirschberg<IS_LCS>(sequence1, startIndex1 + half, size1 - half, sequence2,
+                     startIndex2 + split, size2 - split, runs, forwardRow,
+                     backwardRow);
+}
+}  // namespace internal
+
+// Returns the runs of edit operations of an alignment of
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2) whose number of non-MATCH
+// operations is the Levenshtein distance. Uses Hirschberg's algorithm on top of
+// the rows of levenshteinDistance2_. Takes O(size1 * size2) time. Uses only
+// O(size2) memory besides the returned runs.
+template <class CharSequence>
+std::vector<EditRun> levenshteinAlignment_(const CharSequence &sequence1,
+                                           std::size_t startIndex1,
+                                           std::size_t size1,
+                                           const CharSequence &sequence2,
+                                           std::size_t startIndex2,
+                                           std::size_t size2) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  std::vector<EditRun> runs;
+  std::vector<std::size_t> forwardRow;
+  std::vector<std::size_t> backwardRow;
+
+  internal::hirschberg<false>(sequence1, startIndex1, size1, sequence2,
+                              startIndex2, size2, runs, forwardRow,
+                              backwardRow);
+  return runs;
+}
+
+template <class CharSequence>
+std::vector<EditRun> levenshteinAlignment(const CharSequence &sequence1,
+                                          const CharSequence &sequence2) {
+  return levenshteinAlignment_(sequence1, 0, sequence1.size(), sequence2, 0,
+                               sequence2.size());
+}
+
+// Returns the runs of edit operations of an alignment of
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2) that only uses MATCH, INSERTION,
+// and DELETION, and whose MATCH operations form an LCS. Uses Hirschberg's
+// algorithm on top of the rows of lcsLength2_. Takes O(size1 * size2) time.
+// Uses only O(size2) memory besides the returned runs.
+template <class CharSequence>
+std::vector<EditRun> lcsAlignment_(const CharSequence &sequence1,
+                                   std::size_t startIndex1, std::size_t size1,
+                                   const CharSequence &sequence2,
+                                   std::size_t startIndex2, std::size_t size2) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  std::vector<EditRun> runs;
+  std::vector<std::size_t> forwardRow;
+  std::vector<std::size_t> backwardRow;
+
+  internal::hirschberg<true>(sequence1, startIndex1, size1, sequence2,
+                             startIndex2, size2, runs, forwardRow, backwardRow);
+  return runs;
+}
+
+template <class CharSequence>
+std::vector<EditRun> lcsAlignment(const CharSequence &sequence1,
+                                  const CharSequence &sequence2) {
+  return lcsAlignment_(sequence1, 0, sequence1.size(), sequence2, 0,
+                       sequence2.size());
+}
+
+// Returns an LCS of sequence1 and sequence2. CharSequence must be default
+// constructible and have push_back().
+template <class CharSequence>
+CharSequence longestCommonSubsequence(const CharSequence &sequence1,
+                                      const CharSequence &sequence2) {
+  CharSequence subsequence;
+  std::size_t index1 = 0;
+
+  for (const EditRun &run : lcsAlignment(sequence1, sequence2)) {
+    if (run.operation == EditOperation::MATCH) {
+      for (std::size_t i = 0; i < run.length; ++i) {
+        subsequence.push_back(sequence1[index1 + i]);
+      }
+    }
+
+    if (run.operation != EditOperation::INSERTION) {
+      index1 += run.length;
+    }
+  }
+
+  return subsequence;
+}
+}  // namespace tlo
+
+#endif  // TLO_CPP_ALIGNMENT_HPP
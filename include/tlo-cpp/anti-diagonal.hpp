@@ -0,0 +1,60 @@
+#ifndef TLO_CPP_ANTI_DIAGONAL_HPP
+#define TLO_CPP_ANTI_DIAGONAL_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace tlo {
+namespace internal {
+enum class SimdLevel { NONE, SSE41, AVX2 };
+
+// Returns the widest instruction set the anti-diagonal kernels can use on this
+// CPU. Detected once at runtime. Always SimdLevel::NONE if the library was
+// built without the SIMD kernels.
+SimdLevel simdLevel();
+
+// Number of extra bytes the kernels may read past the end of their sequences
+// and extra cells they may write past the end of each diagonal.
+constexpr std::size_t ANTI_DIAGONAL_PADDING = 32;
+
+// Returns sequence[startIndex, startIndex+size) as bytes followed by
+// ANTI_DIAGONAL_PADDING zero bytes. If reverse is true, the bytes are in
+// reverse order.
+template <class CharSequence>
+std::vector<unsigned char> toAntiDiagonalBytes(const CharSequence &sequence,
+                                               std::size_t startIndex,
+                                               std::size_t size,
+                                               bool reverse) {
+  std::vector<unsigned char> bytes(size + ANTI_DIAGONAL_PADDING, 0);
+
+  for (std::size_t i = 0; i < size; ++i) {
+    std::size_t position = reverse ? size - 1 - i : i;
+
+    bytes[position] = static_cast<unsigned char>(sequence[startIndex + i]);
+  }
+
+  return bytes;
+}
+
+// Returns the Levenshtein distance between sequence1[0, size1) and the reverse
+// of reversedSequence2[0, size2), evaluating the recurrence along
+// anti-diagonals with the instruction set given by level. Uses the narrowest of
+// 8-, 16-, or 32-bit lanes that can hold maxLevenshteinDistance(size1, size2).
+// Both sequences must be followed by ANTI_DIAGONAL_PADDING readable bytes (see
+// toAntiDiagonalBytes()). maxLevenshteinDistance(size1, size2) must be less
+// than UINT32_MAX.
+std::size_t levenshteinDistanceAntiDiagonal(
+    SimdLevel level, const unsigned char *sequence1, std::size_t size1,
+    const unsigned char *reversedSequence2, std::size_t size2);
+
+// Like levenshteinDistanceAntiDiagonal() but returns the length of the LCS.
+// Uses the narrowest lanes that can hold min(size1, size2).
+std::size_t lcsLengthAntiDiagonal(SimdLevel level,
+                                  const unsigned char *sequence1,
+                                  std::size_t size1,
+                                  const unsigned char *reversedSequence2,
+                                  std::size_t size2);
+}  // namespace internal
+}  // namespace tlo
+
+#endif  // TLO_CPP_ANTI_DIAGONAL_HPP
@@ -0,0 +1,117 @@
+#ifndef TLO_CPP_BIT_PARALLEL_HPP
+#define TLO_CPP_BIT_PARALLEL_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tlo {
+namespace internal {
+// Type of the elements of a CharSequence.
+template <class CharSequence>
+using CharOf =
+    std::decay_t<decltype(std::declval<const CharSequence &>()[0])>;
+
+using Word = std::uint64_t;
+
+constexpr std::size_t WORD_SIZE = sizeof(Word) * CHAR_BIT;
+constexpr Word HIGH_BIT = Word{1} << (WORD_SIZE - 1);
+
+// Returns the number of words needed to store size bits.
+constexpr std::size_t numWords(std::size_t size) {
+  return (size + WORD_SIZE - 1) / WORD_SIZE;
+}
+
+// Returns the number of set bits in word. Written so that compilers can turn
+// it into a single popcount instruction where one exists.
+constexpr std::size_t popCount(Word word) {
+  word = word - ((word >> 1) & 0x5555555555555555U);
+  word = (word & 0x3333333333333333U) + ((word >> 2) & 0x3333333333333333U);
+  word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fU;
+  return static_cast<std::size_t>((word * 0x0101010101010101U) >> 56);
+}
+
+// Stores, for each symbol of a pattern, a bit vector of numBlocks() words in
+// which bit i is set if and only if the symbol is at position i of the
+// pattern. Bit vectors of symbols not in the pattern are all zeros. Symbols
+// with sizeof(Char) == 1 are looked up in a direct table. Other symbols are
+// looked up in a hash map.
+template <class Char>
+class PatternMatchVectors {
+ private:
+  static constexpr bool DIRECT_TABLE = sizeof(Char) == 1;
+  static constexpr std::size_t NUM_DIRECT_ROWS = 1 << CHAR_BIT;
+
+  std::size_t numBlocks_ = 0;
+
+  // Row-major table of bit vectors. If DIRECT_TABLE is false, row 0 is all
+  // zeros and is used for symbols not in the pattern.
+  std::vector<Word> vectors_;
+
+  // Maps symbols to rows of vectors_. Only used if DIRECT_TABLE is false.
+  std::unordered_map<Char, std::size_t> rows_;
+
+  static std::size_t directRow(const Char &symbol) {
+    return static_cast<unsigned char>(symbol);
+  }
+
+ public:
+  // Builds the bit vectors for pattern[startIndex, startIndex+size). Reuses
+  // memory from previous calls.
+  template <class CharSequence>
+  void assign(const CharSequence &pattern, std::size_t startIndex,
+              std::size_t size) {
+    numBlocks_ = numWords(size);
+
+    if constexpr (DIRECT_TABLE) {
+      vectors_.assign(NUM_DIRECT_ROWS * numBlocks_, 0);
+
+      for (std::size_t i = 0; i < size; ++i) {
+        std::size_t row = directRow(pattern[startIndex + i]);
+
+        vectors_[row * numBlocks_ + i / WORD_SIZE] |= Word{1}
+                                                      << (i % WORD_SIZE);
+      }
+    } else {
+      vectors_.assign(numBlocks_, 0);
+      rows_.clear();
+
+      for (std::size_t i = 0; i < size; ++i) {
+        auto [iterator, inserted] =
+            rows_.try_emplace(pattern[startIndex + i], rows_.size() + 1);
+
+        if (inserted) {
+          vectors_.resize(vectors_.size() + numBlocks_, 0);
+        }
+
+        vectors_[iterator->second * numBlocks_ + i / WORD_SIZE] |=
+            Word{1} << (i % WORD_SIZE);
+      }
+    }
+  }
+
+  std::size_t numBlocks() const { return numBlocks_; }
+
+  // Returns a pointer to the numBlocks() words of the bit vector of symbol.
+  const Word *get(const Char &symbol) const {
+    if constexpr (DIRECT_TABLE) {
+      return vectors_.data() + directRow(symbol) * numBlocks_;
+    } else {
+      auto iterator = rows_.find(symbol);
+
+      if (iterator == rows_.end()) {
+        return vectors_.data();
+      }
+
+      return vectors_.data() + iterator->second * numBlocks_;
+    }
+  }
+};
+}  // namespace internal
+}  // namespace tlo
+
+#endif  // TLO_CPP_BIT_PARALLEL_HPP
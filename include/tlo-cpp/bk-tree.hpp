@@ -0,0 +1,133 @@
+#ifndef TLO_CPP_BK_TREE_HPP
+#define TLO_CPP_BK_TREE_HPP
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace tlo {
+// Burkhard-Keller tree over values of type Sequence under Metric, a callable
+// that takes two sequences and returns their distance as a std::size_t. The
+// distance must be a metric (e.g. levenshteinDistance3, damerLevenDistance2,
+// or LCS distance). Searches only visit children whose edge distance is within
+// the search radius of the distance to the query, by the triangle inequality.
+// Nodes are stored in a single vector and refer to each other by index.
+template <class Sequence, class Metric>
+class BkTree {
+ private:
+  static constexpr std::size_t NO_NODE =
+      std::numeric_limits<std::size_t>::max();
+
+  struct Node {
+    Sequence value;
+
+    // Distance between value and the value of the parent node.
+    std::size_t distanceToParent;
+
+    // Children form a singly linked list through nextSibling.
+    std::size_t firstChild = NO_NODE;
+    std::size_t nextSibling = NO_NODE;
+  };
+
+  Metric metric_;
+  std::vector<Node> nodes_;
+
+ public:
+  explicit BkTree(Metric metric) : metric_(std::move(metric)) {}
+
+  // Returns the number of values in the tree.
+  std::size_t size() const { return nodes_.size(); }
+
+  bool empty() const { return nodes_.empty(); }
+
+  // Reserves memory for numValues values.
+  void reserve(std::size_t numValues) { nodes_.reserve(numValues); }
+
+  // Inserts value unless it is already in the tree (at distance 0 from a
+  // value in the tree). Returns whether value was inserted.
+  bool insert(Sequence value) {
+    if (nodes_.empty()) {
+      nodes_.push_back({std::move(value), 0});
+      return true;
+    }
+
+    std::size_t node = 0;
+
+    while (true) {
+      std::size_t distance = metric_(value, nodes_[node].value);
+
+      if (distance == 0) {
+        return false;
+      }
+
+      std::size_t child = nodes_[node].firstChild;
+
+      while (child != NO_NODE && nodes_[child].distanceToParent != distance) {
+        child = nodes_[child].nextSibling;
+      }
+
+      if (child == NO_NODE) {
+        std::size_t newNode = nodes_.size();
+
+        nodes_.push_back({std::move(value), distance});
+        nodes_[newNode].nextSibling = nodes_[node].firstChild;
+        nodes_[node].firstChild = newNode;
+        return true;
+      }
+
+      node = child;
+    }
+  }
+
+  // Calls function(value, distance) for each value in the tree whose distance
+  // to query is at most maxDistance, in no particular order.
+  template <class Function>
+  void forEachWithin(const Sequence &query, std::size_t maxDistance,
+                     Function function) const {
+    if (nodes_.empty()) {
+      return;
+    }
+
+    std::vector<std::size_t> stack = {0};
+
+    while (!stack.empty()) {
+      const Node &node = nodes_[stack.back()];
+      std::size_t distance = metric_(query, node.value);
+
+      stack.pop_back();
+
+      if (distance <= maxDistance) {
+        function(node.value, distance);
+      }
+
+      std::size_t minEdge = distance > maxDistance ? distance - maxDistance : 0;
+      std::size_t maxEdge = distance + maxDistance;
+
+      for (std::size_t child = node.firstChild; child != NO_NODE;
+           child = nodes_[child].nextSibling) {
+        std::size_t edge = nodes_[child].distanceToParent;
+
+        if (edge >= minEdge && edge <= maxEdge) {
+          stack.push_back(child);
+        }
+      }
+    }
+  }
+
+  // Returns each value in the tree whose distance to query is at most
+  // maxDistance, paired with that distance, in no particular order.
+  std::vector<std::pair<Sequence, std::size_t>> findWithin(
+      const Sequence &query, std::size_t maxDistance) const {
+    std::vector<std::pair<Sequence, std::size_t>> matches;
+
+    forEachWithin(query, maxDistance,
+                  [&](const Sequence &value, std::size_t distance) {
+                    matches.emplace_back(value, distance);
+                  });
+    return matches;
+  }
+};
+}  // namespace tlo
+
+#endif  // TLO_CPP_BK_TREE_HPP
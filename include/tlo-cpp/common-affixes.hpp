@@ -0,0 +1,108 @@
+#ifndef TLO_CPP_COMMON_AFFIXES_HPP
+#define TLO_CPP_COMMON_AFFIXES_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace tlo {
+namespace internal {
+// Returns the number of leading bytes that bytes1 and bytes2 have in common,
+// looking at no more than size bytes. Compares 16 bytes at a time with SSE2
+// where available and 8 bytes at a time otherwise.
+std::size_t commonPrefixBytes(const unsigned char *bytes1,
+                              const unsigned char *bytes2, std::size_t size);
+
+// Returns the number of bytes ending just before end1 and end2 that they have
+// in common, looking at no more than size bytes.
+std::size_t commonSuffixBytes(const unsigned char *end1,
+                              const unsigned char *end2, std::size_t size);
+
+// value is true if CharSequence stores its elements contiguously at data() and
+// they are integers, which are equal exactly when their bytes are.
+template <class CharSequence, class = void>
+struct HasContiguousIntegers : std::false_type {};
+
+template <class CharSequence>
+struct HasContiguousIntegers<
+    CharSequence,
+    std::void_t<decltype(std::declval<const CharSequence &>().data())>> {
+ private:
+  using Pointer = decltype(std::declval<const CharSequence &>().data());
+  using Element = std::remove_cv_t<std::remove_pointer_t<Pointer>>;
+
+ public:
+  static constexpr bool value = std::is_pointer_v<Pointer> &&
+                                std::is_integral_v<Element> &&
+                                !std::is_same_v<Element, bool>;
+};
+
+struct CommonAffixes {
+  std::size_t prefixLength;
+  std::size_t suffixLength;
+};
+
+// Returns the length of the longest common prefix of
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2), and the length of the longest
+// common suffix of what remains of them once the prefix is removed. Sequences
+// of contiguous integers, like std::string, std::string_view,
+// std::u16string, and std::vector<int>, are compared many bytes at a time.
+template <class CharSequence>
+CommonAffixes commonAffixes(const CharSequence &sequence1,
+                            std::size_t startIndex1, std::size_t size1,
+                            const CharSequence &sequence2,
+                            std::size_t startIndex2, std::size_t size2) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  const std::size_t smallerSize = std::min(size1, size2);
+  CommonAffixes affixes{0, 0};
+
+  if (smallerSize == 0) {
+    return affixes;
+  }
+
+  if constexpr (HasContiguousIntegers<CharSequence>::value) {
+    constexpr std::size_t ELEMENT_SIZE = sizeof(*sequence1.data());
+    const auto *bytes1 =
+        reinterpret_cast<const unsigned char *>(sequence1.data() + startIndex1);
+    const auto *bytes2 =
+        reinterpret_cast<const unsigned char *>(sequence2.data() + startIndex2);
+
+    affixes.prefixLength =
+        commonPrefixBytes(bytes1, bytes2, smallerSize * ELEMENT_SIZE) /
+        ELEMENT_SIZE;
+
+    if (affixes.prefixLength < smallerSize) {
+      affixes.suffixLength =
+          commonSuffixBytes(bytes1 + size1 * ELEMENT_SIZE,
+                            bytes2 + size2 * ELEMENT_SIZE,
+                            (smallerSize - affixes.prefixLength) *
+                                ELEMENT_SIZE) /
+          ELEMENT_SIZE;
+    }
+  } else {
+    while (affixes.prefixLength < smallerSize &&
+           sequence1[startIndex1 + affixes.prefixLength] ==
+               sequence2[startIndex2 + affixes.prefixLength]) {
+      affixes.prefixLength++;
+    }
+
+    const std::size_t remainingLength = smallerSize - affixes.prefixLength;
+
+    while (affixes.suffixLength < remainingLength &&
+           sequence1[startIndex1 + size1 - 1 - affixes.suffixLength] ==
+               sequence2[startIndex2 + size2 - 1 - affixes.suffixLength]) {
+      affixes.suffixLength++;
+    }
+  }
+
+  return affixes;
+}
+}  // namespace internal
+}  // namespace tlo
+
+#endif  // TLO_CPP_COMMON_AFFIXES_HPP
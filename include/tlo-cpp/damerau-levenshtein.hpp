@@ -2,10 +2,22 @@
 #define TLO_CPP_DAMERAU_LEVENSHTEIN_HPP
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <climits>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include "tlo-cpp/bit-parallel.hpp"
+#include "tlo-cpp/common-affixes.hpp"
+#include "tlo-cpp/dp-table.hpp"
+#include "tlo-cpp/edit-distance-workspace.hpp"
+#include "tlo-cpp/similarity.hpp"
+
 #ifdef TLO_CPP_DEBUG_DAMERAU_LEVENSHTEIN
 #include <iostream>
 #endif
@@ -19,64 +31,139 @@ namespace internal {
 constexpr std::size_t NUM_CHARS = 1 << CHAR_BIT;
 }  // namespace internal
 
-// Returns the Damerau-Levenshtein distance between
-// sequence1[startIndex1, startIndex1+size1) and
-// sequence2[startIndex2, startIndex2+size2). Takes O(size1 * size2) time.
-// Uses O(size1 * size2) memory.
-template <class CharSequence>
-std::size_t damerLevenDistance1_(const CharSequence &sequence1,
-                                 std::size_t startIndex1, std::size_t size1,
-                                 const CharSequence &sequence2,
-                                 std::size_t startIndex2, std::size_t size2) {
-  assert(startIndex1 + size1 <= sequence1.size());
-  assert(startIndex2 + size2 <= sequence2.size());
+namespace internal {
+// Assigns the ids 0, 1, ... to symbols in order of first appearance. Symbols
+// with sizeof(Char) == 1 are looked up in a direct table that does not
+// allocate. Other symbols are looked up in an open-addressed hash table sized
+// for the number of symbols given to the constructor, so Char must work with
+// std::hash and ==.
+template <class Char>
+class DenseAlphabet {
+ private:
+  static constexpr bool DIRECT_TABLE = sizeof(Char) == 1;
+  static constexpr std::uint32_t NO_ID =
+      std::numeric_limits<std::uint32_t>::max();
+
+  std::uint32_t size_ = 0;
+
+  // Maps bytes to ids. Only used if DIRECT_TABLE is true.
+  std::array<std::uint32_t, DIRECT_TABLE ? NUM_CHARS : 0> directIds_{};
+
+  // Hash table of symbols and their ids with a power of two number of slots.
+  // Only used if DIRECT_TABLE is false.
+  std::vector<Char> symbols_;
+  std::vector<std::uint32_t> ids_;
+
+  std::size_t slotOf(const Char &symbol) const {
+    // Spreads the bits of std::hash, which is the identity for integers.
+    std::uint64_t hash =
+        std::uint64_t{std::hash<Char>{}(symbol)} * 0x9e3779b97f4a7c15U;
+    std::size_t mask = ids_.size() - 1;
+    std::size_t slot = static_cast<std::size_t>(hash >> 32) & mask;
+
+    while (ids_[slot] != NO_ID && !(symbols_[slot] == symbol)) {
+      slot = (slot + 1) & mask;
+    }
 
-  if (size1 == 0 || size2 == 0) {
-    return maxDamerLevenDistance(size1, size2);
+    return slot;
   }
 
-  // distances[m + 1][n + 1] will store the Damerau-Levenshtein distance between
-  // sequence1[startIndex1, startIndex1+m) and
-  // sequence2[startIndex2, startIndex2+n).
-  std::vector<std::vector<std::size_t>> distances(
-      size1 + 2, std::vector<std::size_t>(size2 + 2, 0));
+ public:
+  explicit DenseAlphabet(std::size_t maxNumSymbols) {
+    if constexpr (DIRECT_TABLE) {
+      directIds_.fill(NO_ID);
+    } else {
+      std::size_t numSlots = 2;
+
+      while (numSlots < 2 * maxNumSymbols) {
+        numSlots *= 2;
+      }
+
+      symbols_.resize(numSlots);
+      ids_.assign(numSlots, NO_ID);
+    }
+  }
+
+  // Returns the id of symbol, assigning the next id if symbol is new.
+  std::uint32_t idOf(const Char &symbol) {
+    if constexpr (DIRECT_TABLE) {
+      std::uint32_t &id = directIds_[static_cast<unsigned char>(symbol)];
+
+      if (id == NO_ID) {
+        id = size_++;
+      }
+
+      return id;
+    } else {
+      std::size_t slot = slotOf(symbol);
+
+      if (ids_[slot] == NO_ID) {
+        symbols_[slot] = symbol;
+        ids_[slot] = size_++;
+      }
+
+      return ids_[slot];
+    }
+  }
+
+  // Returns the number of ids assigned so far.
+  std::size_t size() const { return size_; }
+};
+
+// Implements damerLevenDistance1_ on sequences of dense symbol ids in
+// [0, numSymbols) using a table of Cell whose memory comes from workspace.
+// Cell must be able to hold maxDamerLevenDistance(ids1.size(), ids2.size()).
+template <class Cell>
+std::size_t damerLevenDistance1WithCells(const std::vector<std::uint32_t> &ids1,
+                                         const std::vector<std::uint32_t> &ids2,
+                                         std::size_t numSymbols,
+                                         EditDistanceWorkspace &workspace) {
+  const std::size_t size1 = ids1.size();
+  const std::size_t size2 = ids2.size();
+
+  // distances(m + 1, n + 1) will store the Damerau-Levenshtein distance between
+  // the first m symbols of ids1 and the first n symbols of ids2.
+  DpTable<Cell> distances(size1 + 2, size2 + 2,
+                          std::move(workspace.cells<Cell>()));
   const std::size_t maxDistance = maxDamerLevenDistance(size1, size2);
   const std::size_t lastRow = size1 + 1;
   const std::size_t lastCol = size2 + 1;
 
-  distances[0][0] = maxDistance;
+  distances(0, 0) = static_cast<Cell>(maxDistance);
 
   for (std::size_t row = 1; row <= lastRow; ++row) {
-    distances[row][0] = maxDistance;
-    distances[row][1] = row - 1;
+    distances(row, 0) = static_cast<Cell>(maxDistance);
+    distances(row, 1) = static_cast<Cell>(row - 1);
   }
 
   for (std::size_t col = 1; col <= lastCol; ++col) {
-    distances[0][col] = maxDistance;
-    distances[1][col] = col - 1;
+    distances(0, col) = static_cast<Cell>(maxDistance);
+    distances(1, col) = static_cast<Cell>(col - 1);
   }
 
-  std::vector<std::size_t> rowsOfSeq1(internal::NUM_CHARS, 1);
+  std::vector<std::size_t> &rowsOfSeq1 = workspace.symbolRows();
+
+  rowsOfSeq1.assign(numSymbols, 1);
 
   for (std::size_t i = 0; i < size1; ++i) {
     std::size_t row = i + 2;
-    auto charInSeq1 = static_cast<unsigned char>(sequence1[startIndex1 + i]);
+    std::uint32_t charInSeq1 = ids1[i];
     std::size_t colOfSeq2 = 1;
 
     for (std::size_t j = 0; j < size2; ++j) {
       std::size_t col = j + 2;
-      auto charInSeq2 = static_cast<unsigned char>(sequence2[startIndex2 + j]);
+      std::uint32_t charInSeq2 = ids2[j];
       std::size_t rowForCharInSeq2 = rowsOfSeq1[charInSeq2];
       std::size_t colForCharInSeq1 = colOfSeq2;
 
-      std::size_t deletionCost = distances[row - 1][col] + 1;
-      std::size_t insertionCost = distances[row][col - 1] + 1;
-      std::size_t substitutionCost = distances[row - 1][col - 1];
+      std::size_t deletionCost = std::size_t{distances(row - 1, col)} + 1;
+      std::size_t insertionCost = std::size_t{distances(row, col - 1)} + 1;
+      std::size_t substitutionCost = distances(row - 1, col - 1);
       std::size_t transpositionCost;
 
       if (i > 0 && j > 0) {
         transpositionCost =
-            distances[rowForCharInSeq2 - 1][colForCharInSeq1 - 1] +
+            std::size_t{distances(rowForCharInSeq2 - 1, colForCharInSeq1 - 1)} +
             (row - rowForCharInSeq2 - 1) + 1 + (col - colForCharInSeq1 - 1);
       } else {
         transpositionCost = maxDistance;
@@ -88,8 +175,8 @@ std::size_t damerLevenDistance1_(const CharSequence &sequence1,
         colOfSeq2 = col;
       }
 
-      distances[row][col] = std::min(
-          {deletionCost, insertionCost, substitutionCost, transpositionCost});
+      distances(row, col) = static_cast<Cell>(std::min(
+          {deletionCost, insertionCost, substitutionCost, transpositionCost}));
     }
 
     rowsOfSeq1[charInSeq1] = row;
@@ -99,13 +186,73 @@ std::size_t damerLevenDistance1_(const CharSequence &sequence1,
   std::cerr << __func__ << " distances:" << std::endl;
   for (std::size_t i = 0; i <= lastRow; ++i) {
     for (std::size_t j = 0; j <= lastCol; ++j) {
-      std::cerr << distances[i][j] << " ";
+      std::cerr << std::size_t{distances(i, j)} << " ";
     }
     std::cerr << std::endl;
   }
 #endif
 
-  return distances[lastRow][lastCol];
+  const std::size_t distance = distances(lastRow, lastCol);
+
+  workspace.cells<Cell>() = distances.release();
+  return distance;
+}
+}  // namespace internal
+
+// Returns the Damerau-Levenshtein distance between
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2). Works for any element type that
+// works with std::hash and == by first mapping the elements of both sequences
+// to dense ids. Takes O(size1 * size2) time. Uses O(size1 * size2) memory in a
+// single contiguous table whose cells are the narrowest unsigned integers that
+// can hold maxDamerLevenDistance(size1, size2), plus O(size1 + size2) memory
+// for the ids, all of it from workspace. Elements wider than a byte also need
+// a small hash table that is allocated on every call.
+template <class CharSequence>
+std::size_t damerLevenDistance1WithWorkspace_(
+    const CharSequence &sequence1, std::size_t startIndex1, std::size_t size1,
+    const CharSequence &sequence2, std::size_t startIndex2, std::size_t size2,
+    EditDistanceWorkspace &workspace) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  if (size1 == 0 || size2 == 0) {
+    return maxDamerLevenDistance(size1, size2);
+  }
+
+  internal::DenseAlphabet<internal::CharOf<CharSequence>> alphabet(
+      size1 + size2);
+  std::vector<std::uint32_t> &ids1 = workspace.ids1();
+  std::vector<std::uint32_t> &ids2 = workspace.ids2();
+
+  ids1.resize(size1);
+  ids2.resize(size2);
+
+  for (std::size_t i = 0; i < size1; ++i) {
+    ids1[i] = alphabet.idOf(sequence1[startIndex1 + i]);
+  }
+
+  for (std::size_t j = 0; j < size2; ++j) {
+    ids2[j] = alphabet.idOf(sequence2[startIndex2 + j]);
+  }
+
+  return internal::withNarrowestCell(
+      maxDamerLevenDistance(size1, size2), [&](auto cell) {
+        return internal::damerLevenDistance1WithCells<decltype(cell)>(
+            ids1, ids2, alphabet.size(), workspace);
+      });
+}
+
+// Like damerLevenDistance1WithWorkspace_ but uses the workspace of the calling
+// thread.
+template <class CharSequence>
+std::size_t damerLevenDistance1_(const CharSequence &sequence1,
+                                 std::size_t startIndex1, std::size_t size1,
+                                 const CharSequence &sequence2,
+                                 std::size_t startIndex2, std::size_t size2) {
+  return damerLevenDistance1WithWorkspace_(
+      sequence1, startIndex1, size1, sequence2, startIndex2, size2,
+      EditDistanceWorkspace::threadLocal());
 }
 
 template <class CharSequence>
@@ -117,53 +264,394 @@ std::size_t damerLevenDistance1(const CharSequence &sequence1,
 
 // Returns the Damerau-Levenshtein distance between
 // sequence1[startIndex1, startIndex1+size1) and
-// sequence2[startIndex2, startIndex2+size2). Does additional optimizations on
-// top of damerLevenDistance1_.
+// sequence2[startIndex2, startIndex2+size2). Computes the same recurrence as
+// damerLevenDistance1_ but only keeps the last three rows. A transposition
+// that skips at least two elements of both sequences never beats plain edits,
+// so the only distant cells that matter are the ones one row above the last
+// match of each element of sequence2 in sequence1, which are saved per column
+// of the shorter sequence. Works for elements of any type. Takes
+// O(size1 * size2) time. Uses only O(min(size1, size2)) memory.
 template <class CharSequence>
-std::size_t damerLevenDistance2_(
-    const CharSequence &sequence1, std::size_t startIndex1, std::size_t size1,
-    const CharSequence &sequence2, std::size_t startIndex2, std::size_t size2,
-    std::size_t (*damerLevenDistance)(
-        const CharSequence &, std::size_t, std::size_t, const CharSequence &,
-        std::size_t, std::size_t) = damerLevenDistance1_<CharSequence>) {
+std::size_t damerLevenDistance3_(const CharSequence &sequence1,
+                                 std::size_t startIndex1, std::size_t size1,
+                                 const CharSequence &sequence2,
+                                 std::size_t startIndex2, std::size_t size2) {
+  if (size1 < size2) {
+    return damerLevenDistance3_(sequence2, startIndex2, size2, sequence1,
+                                startIndex1, size1);
+  }
+
   assert(startIndex1 + size1 <= sequence1.size());
   assert(startIndex2 + size2 <= sequence2.size());
+  assert(size2 <= size1);
 
   if (size1 == 0 || size2 == 0) {
     return maxDamerLevenDistance(size1, size2);
   }
 
-  std::size_t prefixLength = 0;
+  const std::size_t maxDistance = maxDamerLevenDistance(size1, size2);
+
+  // distances[n] will store the Damerau-Levenshtein distance between
+  // sequence1[startIndex1, startIndex1+m) and
+  // sequence2[startIndex2, startIndex2+n) for the current row m.
+  // previousDistances and secondPreviousDistances hold rows m-1 and m-2.
+  std::vector<std::size_t> distances(size2 + 1);
+  std::vector<std::size_t> previousDistances(size2 + 1);
+  std::vector<std::size_t> secondPreviousDistances(size2 + 1, maxDistance);
+
+  // If sequence2[startIndex2+j] was last seen in sequence1 at index k (relative
+  // to startIndex1), rowsOfMatches[j] is k + 1 and distancesBeforeMatches[j] is
+  // the distance between sequence1[startIndex1, startIndex1+k) and
+  // sequence2[startIndex2, startIndex2+j-1). rowsOfMatches[j] is 0 if there is
+  // no such k.
+  std::vector<std::size_t> rowsOfMatches(size2, 0);
+  std::vector<std::size_t> distancesBeforeMatches(size2, maxDistance);
+
+  for (std::size_t j = 0; j <= size2; ++j) {
+    distances[j] = j;
+  }
+
+  for (std::size_t i = 0; i < size1; ++i) {
+    std::size_t row = i + 1;
+    const auto &charInSeq1 = sequence1[startIndex1 + i];
+
+    secondPreviousDistances.swap(previousDistances);
+    previousDistances.swap(distances);
+    distances[0] = row;
+
+    // Column (relative to startIndex2) after the last match of charInSeq1 in
+    // sequence2 so far in this row, or 0 if there is none.
+    std::size_t colOfMatch = 0;
+
+    for (std::size_t j = 0; j < size2; ++j) {
+      std::size_t col = j + 1;
+      const auto &charInSeq2 = sequence2[startIndex2 + j];
+
+      std::size_t deletionCost = previousDistances[col] + 1;
+      std::size_t insertionCost = distances[col - 1] + 1;
+      std::size_t substitutionCost = previousDistances[col - 1];
+      std::size_t transpositionCost = maxDistance;
+
+      if (charInSeq1 != charInSeq2) {
+        substitutionCost++;
+
+        // charInSeq2 is the previous element of sequence1 and charInSeq1 was
+        // last seen earlier in this row.
+        if (i > 0 && colOfMatch > 0 &&
+            sequence1[startIndex1 + i - 1] == charInSeq2) {
+          transpositionCost = secondPreviousDistances[colOfMatch - 1] +
+                              (col - colOfMatch - 1) + 1;
+        }
+
+        // charInSeq1 is the previous element of sequence2 and charInSeq2 was
+        // last seen earlier in sequence1.
+        if (colOfMatch == col - 1 && rowsOfMatches[j] > 0) {
+          transpositionCost =
+              std::min(transpositionCost, distancesBeforeMatches[j] +
+                                              (row - rowsOfMatches[j] - 1) + 1);
+        }
+      } else {
+        colOfMatch = col;
+
+        if (j > 0) {
+          rowsOfMatches[j] = row;
+          distancesBeforeMatches[j] = previousDistances[col - 2];
+        }
+      }
 
-  for (std::size_t i = 0; i < size1 && i < size2; ++i) {
-    if (sequence1[startIndex1 + i] != sequence2[startIndex2 + i]) {
-      break;
+      distances[col] = std::min(
+          {deletionCost, insertionCost, substitutionCost, transpositionCost});
     }
+  }
 
-    prefixLength++;
+#ifdef TLO_CPP_DEBUG_DAMERAU_LEVENSHTEIN
+  std::cerr << __func__ << " distances:" << std::endl;
+  for (std::size_t j = 0; j <= size2; ++j) {
+    std::cerr << distances[j] << " ";
   }
+  std::cerr << std::endl;
+#endif
 
-  std::size_t smallerSize = std::min(size1, size2);
-  std::size_t largerSize = std::max(size1, size2);
+  return distances[size2];
+}
 
-  if (prefixLength == smallerSize) {
-    return largerSize - smallerSize;
+template <class CharSequence>
+std::size_t damerLevenDistance3(const CharSequence &sequence1,
+                                const CharSequence &sequence2) {
+  return damerLevenDistance3_(sequence1, 0, sequence1.size(), sequence2, 0,
+                              sequence2.size());
+}
+
+// Returns the Damerau-Levenshtein distance between
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2). Runs the recurrence of
+// damerLevenDistance3_ with its rows and per-column match state in
+// std::arrays sized by CAPACITY instead of heap-allocated vectors, so it can be
+// evaluated at compile time, e.g. on std::string_view or std::array. Throws
+// std::length_error if min(size1, size2) > CAPACITY, which fails compilation
+// in a constant expression. Takes O(size1 * size2) time.
+template <std::size_t CAPACITY, class CharSequence>
+constexpr std::size_t damerLevenDistanceFixed_(const CharSequence &sequence1,
+                                               std::size_t startIndex1,
+                                               std::size_t size1,
+                                               const CharSequence &sequence2,
+                                               std::size_t startIndex2,
+                                               std::size_t size2) {
+  if (size1 < size2) {
+    return damerLevenDistanceFixed_<CAPACITY>(sequence2, startIndex2, size2,
+                                              sequence1, startIndex1, size1);
+  }
+
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+  assert(size2 <= size1);
+
+  if (size2 > CAPACITY) {
+    throw std::length_error(
+        "Error: Sequences are too long for damerLevenDistanceFixed_.");
+  }
+
+  // maxDamerLevenDistance is not constexpr, but it is just size1 here.
+  const std::size_t maxDistance = size1;
+
+  // rows[row % 3] is the row of damerLevenDistance3_ for the given row, since
+  // std::swap cannot be used in constant expressions. Rows -1 and -2 are
+  // initialized to maxDistance, like secondPreviousDistances there.
+  std::array<std::array<std::size_t, CAPACITY + 1>, 3> rows{};
+  std::array<std::size_t, CAPACITY> rowsOfMatches{};
+  std::array<std::size_t, CAPACITY> distancesBeforeMatches{};
+
+  for (std::size_t j = 0; j <= size2; ++j) {
+    rows[0][j] = j;
+    rows[1][j] = maxDistance;
+    rows[2][j] = maxDistance;
+  }
+
+  for (std::size_t j = 0; j < size2; ++j) {
+    distancesBeforeMatches[j] = maxDistance;
   }
 
-  std::size_t remainingLength = smallerSize - prefixLength;
-  std::size_t suffixLength = 0;
+  for (std::size_t i = 0; i < size1; ++i) {
+    std::size_t row = i + 1;
+    const auto &charInSeq1 = sequence1[startIndex1 + i];
+    auto &distances = rows[row % 3];
+    const auto &previousDistances = rows[i % 3];
+    const auto &secondPreviousDistances = rows[(i + 2) % 3];
+
+    distances[0] = row;
+
+    std::size_t colOfMatch = 0;
 
-  for (std::size_t i = size1 - 1, j = size2 - 1; i < size1 && j < size2;
-       --i, --j) {
-    if (sequence1[startIndex1 + i] != sequence2[startIndex2 + j]) {
-      break;
+    for (std::size_t j = 0; j < size2; ++j) {
+      std::size_t col = j + 1;
+      const auto &charInSeq2 = sequence2[startIndex2 + j];
+
+      std::size_t deletionCost = previousDistances[col] + 1;
+      std::size_t insertionCost = distances[col - 1] + 1;
+      std::size_t substitutionCost = previousDistances[col - 1];
+      std::size_t transpositionCost = maxDistance;
+
+      if (charInSeq1 != charInSeq2) {
+        substitutionCost++;
+
+        if (i > 0 && colOfMatch > 0 &&
+            sequence1[startIndex1 + i - 1] == charInSeq2) {
+          transpositionCost = secondPreviousDistances[colOfMatch - 1] +
+                              (col - colOfMatch - 1) + 1;
+        }
+
+        if (colOfMatch == col - 1 && rowsOfMatches[j] > 0) {
+          transpositionCost =
+              std::min(transpositionCost, distancesBeforeMatches[j] +
+                                              (row - rowsOfMatches[j] - 1) + 1);
+        }
+      } else {
+        colOfMatch = col;
+
+        if (j > 0) {
+          rowsOfMatches[j] = row;
+          distancesBeforeMatches[j] = previousDistances[col - 2];
+        }
+      }
+
+      distances[col] = std::min(
+          {deletionCost, insertionCost, substitutionCost, transpositionCost});
     }
+  }
+
+  return rows[size1 % 3][size2];
+}
+
+template <std::size_t CAPACITY, class CharSequence>
+constexpr std::size_t damerLevenDistanceFixed(const CharSequence &sequence1,
+                                              const CharSequence &sequence2) {
+  return damerLevenDistanceFixed_<CAPACITY>(sequence1, 0, sequence1.size(),
+                                            sequence2, 0, sequence2.size());
+}
+
+namespace internal {
+// Bit vectors of one block of the pattern for the bit-vector OSA distance.
+struct OsaBlock {
+  Word positiveVertical = ~Word{0};
+  Word negativeVertical = 0;
+
+  // Diagonal zero vector and match vector of the previous text element.
+  Word diagonalZero = 0;
+  Word matches = 0;
+};
+
+// Returns the optimal string alignment distance between the pattern described
+// by patternMatchVectors (of size patternSize > 0) and
+// text[startIndex, startIndex+size). Extends Myers' bit-vector algorithm with
+// a transposition vector, carrying the horizontal deltas and the transposition
+// bit across block boundaries. Based on "A Bit-Vector Algorithm for Computing
+// Levenshtein and Damerau Edit Distances" by Heikki Hyyro. blocks is a scratch
+// buffer.
+template <class CharSequence, class Char>
+std::size_t osaDistanceBitParallel(
+    const PatternMatchVectors<Char> &patternMatchVectors,
+    std::size_t patternSize, const CharSequence &text, std::size_t startIndex,
+    std::size_t size, std::vector<OsaBlock> &blocks) {
+  assert(patternSize > 0);
+  assert(startIndex + size <= text.size());
+
+  const std::size_t numBlocks = patternMatchVectors.numBlocks();
+  const Word lastBit = Word{1} << ((patternSize - 1) % WORD_SIZE);
+  std::size_t distance = patternSize;
+
+  blocks.assign(numBlocks, OsaBlock{});
+
+  for (std::size_t i = 0; i < size; ++i) {
+    const Word *matches = patternMatchVectors.get(text[startIndex + i]);
+    Word positiveCarry = 1;
+    Word negativeCarry = 0;
+
+    // Diagonal zero vector of the previous text element and match vector of
+    // the current text element of the previous block.
+    Word previousDiagonalZero = 0;
+    Word previousMatches = 0;
+
+    for (std::size_t block = 0; block < numBlocks; ++block) {
+      OsaBlock &vectors = blocks[block];
+      Word match = matches[block];
+      Word transposition =
+          (((~vectors.diagonalZero & match) << 1) |
+           ((~previousDiagonalZero & previousMatches) >> (WORD_SIZE - 1))) &
+          vectors.matches;
+
+      previousDiagonalZero = vectors.diagonalZero;
+      previousMatches = match;
+
+      Word carriedMatch = match | negativeCarry;
+      Word diagonalZero = (((carriedMatch & vectors.positiveVertical) +
+                            vectors.positiveVertical) ^
+                           vectors.positiveVertical) |
+                          carriedMatch | vectors.negativeVertical |
+                          transposition;
+      Word positiveHorizontal =
+          vectors.negativeVertical | ~(diagonalZero | vectors.positiveVertical);
+      Word negativeHorizontal = diagonalZero & vectors.positiveVertical;
+
+      if (block + 1 == numBlocks) {
+        if (positiveHorizontal & lastBit) {
+          distance++;
+        } else if (negativeHorizontal & lastBit) {
+          distance--;
+        }
+      }
 
-    if (suffixLength == remainingLength) {
-      break;
+      Word nextPositiveCarry = positiveHorizontal >> (WORD_SIZE - 1);
+      Word nextNegativeCarry = negativeHorizontal >> (WORD_SIZE - 1);
+
+      positiveHorizontal = (positiveHorizontal << 1) | positiveCarry;
+      negativeHorizontal = (negativeHorizontal << 1) | negativeCarry;
+      positiveCarry = nextPositiveCarry;
+      negativeCarry = nextNegativeCarry;
+
+      vectors.positiveVertical =
+          negativeHorizontal | ~(diagonalZero | positiveHorizontal);
+      vectors.negativeVertical = positiveHorizontal & diagonalZero;
+      vectors.diagonalZero = diagonalZero;
+      vectors.matches = match;
     }
+  }
+
+  return distance;
+}
+}  // namespace internal
+
+// Returns the optimal string alignment distance between
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2), which is the restricted
+// Damerau-Levenshtein distance: no substring may be edited more than once, so
+// it can be larger than damerLevenDistance1_ (e.g. 3 instead of 2 for "CA" and
+// "ABC"). Can be used as the damerLevenDistance of damerLevenDistance2_. Uses
+// Hyyro's bit-vector algorithm with the shorter sequence as the pattern. Takes
+// O(ceil(min(size1, size2) / 64) * max(size1, size2)) time. Uses
+// O(ceil(min(size1, size2) / 64)) memory plus a table of bit vectors for the
+// alphabet of the shorter sequence.
+template <class CharSequence>
+std::size_t damerLevenDistanceOsa_(const CharSequence &sequence1,
+                                   std::size_t startIndex1, std::size_t size1,
+                                   const CharSequence &sequence2,
+                                   std::size_t startIndex2, std::size_t size2) {
+  if (size1 < size2) {
+    return damerLevenDistanceOsa_(sequence2, startIndex2, size2, sequence1,
+                                  startIndex1, size1);
+  }
+
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+  assert(size2 <= size1);
+
+  if (size1 == 0 || size2 == 0) {
+    return maxDamerLevenDistance(size1, size2);
+  }
+
+  internal::PatternMatchVectors<internal::CharOf<CharSequence>>
+      patternMatchVectors;
+  std::vector<internal::OsaBlock> blocks;
+
+  patternMatchVectors.assign(sequence2, startIndex2, size2);
+  return internal::osaDistanceBitParallel(patternMatchVectors, size2,
+                                          sequence1, startIndex1, size1,
+                                          blocks);
+}
+
+template <class CharSequence>
+std::size_t damerLevenDistanceOsa(const CharSequence &sequence1,
+                                  const CharSequence &sequence2) {
+  return damerLevenDistanceOsa_(sequence1, 0, sequence1.size(), sequence2, 0,
+                                sequence2.size());
+}
+
+// Returns the Damerau-Levenshtein distance between
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2). Does additional optimizations on
+// top of damerLevenDistance1_.
+template <class CharSequence>
+std::size_t damerLevenDistance2_(
+    const CharSequence &sequence1, std::size_t startIndex1, std::size_t size1,
+    const CharSequence &sequence2, std::size_t startIndex2, std::size_t size2,
+    std::size_t (*damerLevenDistance)(
+        const CharSequence &, std::size_t, std::size_t, const CharSequence &,
+        std::size_t, std::size_t) = damerLevenDistance1_<CharSequence>) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
 
-    suffixLength++;
+  if (size1 == 0 || size2 == 0) {
+    return maxDamerLevenDistance(size1, size2);
+  }
+
+  const internal::CommonAffixes affixes = internal::commonAffixes(
+      sequence1, startIndex1, size1, sequence2, startIndex2, size2);
+  const std::size_t prefixLength = affixes.prefixLength;
+  const std::size_t suffixLength = affixes.suffixLength;
+  std::size_t smallerSize = std::min(size1, size2);
+  std::size_t largerSize = std::max(size1, size2);
+
+  if (prefixLength == smallerSize) {
+    return largerSize - smallerSize;
   }
 
   return damerLevenDistance(sequence1, startIndex1 + prefixLength,
@@ -181,6 +669,172 @@ std::size_t damerLevenDistance2(
   return damerLevenDistance2_(sequence1, 0, sequence1.size(), sequence2, 0,
                               sequence2.size(), damerLevenDistance);
 }
+
+// Returns the Damerau-Levenshtein distance between
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2) if it is at most maxDistance.
+// Otherwise, returns maxDistance + 1. Computes the recurrence of
+// damerLevenDistance3_ but only on the diagonal band of width
+// 2 * maxDistance + 1, and stops once a row exceeds maxDistance everywhere.
+// Every cell of the row before it is then at least maxDistance, because of the
+// deletion edge, so a transposition that skips that row costs more than
+// maxDistance too. Takes O(max(size1, size2) * maxDistance) time. Uses only
+// O(min(size1, size2)) memory.
+template <class CharSequence>
+std::size_t damerLevenDistanceBounded_(const CharSequence &sequence1,
+                                       std::size_t startIndex1,
+                                       std::size_t size1,
+                                       const CharSequence &sequence2,
+                                       std::size_t startIndex2,
+                                       std::size_t size2,
+                                       std::size_t maxDistance) {
+  if (size1 < size2) {
+    return damerLevenDistanceBounded_(sequence2, startIndex2, size2,
+                                      sequence1, startIndex1, size1,
+                                      maxDistance);
+  }
+
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+  assert(size2 <= size1);
+
+  if (size1 - size2 > maxDistance) {
+    return maxDistance + 1;
+  }
+
+  if (maxDistance >= maxDamerLevenDistance(size1, size2)) {
+    return damerLevenDistance2_(sequence1, startIndex1, size1, sequence2,
+                                startIndex2, size2);
+  }
+
+  // Any distance greater than maxDistance is stored as limit. Cells outside
+  // the band are always greater than maxDistance, so they hold limit too.
+  const std::size_t limit = maxDistance + 1;
+
+  // Same as in damerLevenDistance3_.
+  std::vector<std::size_t> distances(size2 + 1, limit);
+  std::vector<std::size_t> previousDistances(size2 + 1, limit);
+  std::vector<std::size_t> secondPreviousDistances(size2 + 1, limit);
+  std::vector<std::size_t> rowsOfMatches(size2, 0);
+  std::vector<std::size_t> distancesBeforeMatches(size2, limit);
+
+  for (std::size_t col = 0; col <= size2 && col < limit; ++col) {
+    distances[col] = col;
+  }
+
+  for (std::size_t i = 0; i < size1; ++i) {
+    std::size_t row = i + 1;
+    std::size_t firstCol = row > maxDistance ? row - maxDistance : 1;
+    std::size_t lastCol = std::min(size2, row + maxDistance);
+    const auto &charInSeq1 = sequence1[startIndex1 + i];
+
+    secondPreviousDistances.swap(previousDistances);
+    previousDistances.swap(distances);
+    distances[firstCol - 1] = firstCol == 1 ? std::min(row, limit) : limit;
+
+    // The rows are reused, so clear what the next two rows read just right of
+    // this band.
+    for (std::size_t col = lastCol + 1; col <= size2 && col <= lastCol + 2;
+         ++col) {
+      distances[col] = limit;
+    }
+
+    std::size_t minDistanceInRow = distances[firstCol - 1];
+
+    // A match left of the band only matters if it is right next to it.
+    std::size_t colOfMatch =
+        firstCol > 1 && sequence2[startIndex2 + firstCol - 2] == charInSeq1
+            ? firstCol - 1
+            : 0;
+
+    for (std::size_t col = firstCol; col <= lastCol; ++col) {
+      std::size_t j = col - 1;
+      const auto &charInSeq2 = sequence2[startIndex2 + j];
+
+      std::size_t deletionCost = previousDistances[col] + 1;
+      std::size_t insertionCost = distances[col - 1] + 1;
+      std::size_t substitutionCost = previousDistances[col - 1];
+      std::size_t transpositionCost = limit;
+
+      if (charInSeq1 != charInSeq2) {
+        substitutionCost++;
+
+        if (i > 0 && colOfMatch > 0 &&
+            sequence1[startIndex1 + i - 1] == charInSeq2) {
+          transpositionCost = secondPreviousDistances[colOfMatch - 1] +
+                              (col - colOfMatch - 1) + 1;
+        }
+
+        if (colOfMatch == col - 1 && rowsOfMatches[j] > 0) {
+          transpositionCost =
+              std::min(transpositionCost, distancesBeforeMatches[j] +
+                                              (row - rowsOfMatches[j] - 1) + 1);
+        }
+      } else {
+        colOfMatch = col;
+
+        if (j > 0) {
+          rowsOfMatches[j] = row;
+          distancesBeforeMatches[j] = previousDistances[col - 2];
+        }
+      }
+
+      distances[col] = std::min({deletionCost, insertionCost, substitutionCost,
+                                 transpositionCost, limit});
+      minDistanceInRow = std::min(minDistanceInRow, distances[col]);
+    }
+
+    if (minDistanceInRow > maxDistance) {
+      return limit;
+    }
+  }
+
+  return distances[size2];
+}
+
+template <class CharSequence>
+std::size_t damerLevenDistanceBounded(const CharSequence &sequence1,
+                                      const CharSequence &sequence2,
+                                      std::size_t maxDistance) {
+  return damerLevenDistanceBounded_(sequence1, 0, sequence1.size(), sequence2,
+                                    0, sequence2.size(), maxDistance);
+}
+
+// Returns 1 - damerLevenDistance / maxDamerLevenDistance, which is 1 for equal
+// sequences and 0 for sequences with nothing in common, if that is at least
+// minSimilarity. Otherwise, returns 0. minSimilarity is turned into the
+// maxDistance of damerLevenDistanceBounded_, so pairs far below it are
+// rejected early.
+template <class CharSequence>
+double damerLevenSimilarity_(const CharSequence &sequence1,
+                             std::size_t startIndex1, std::size_t size1,
+                             const CharSequence &sequence2,
+                             std::size_t startIndex2, std::size_t size2,
+                             double minSimilarity = 0.0) {
+  const std::size_t maxDistance = maxDamerLevenDistance(size1, size2);
+  const std::size_t allowedDistance =
+      internal::maxDistanceForSimilarity(maxDistance, minSimilarity);
+
+  if (allowedDistance > maxDistance) {
+    return 0.0;
+  }
+
+  const std::size_t distance =
+      damerLevenDistanceBounded_(sequence1, startIndex1, size1, sequence2,
+                                 startIndex2, size2, allowedDistance);
+
+  return distance > allowedDistance
+             ? 0.0
+             : internal::similarity(distance, maxDistance);
+}
+
+template <class CharSequence>
+double damerLevenSimilarity(const CharSequence &sequence1,
+                            const CharSequence &sequence2,
+                            double minSimilarity = 0.0) {
+  return damerLevenSimilarity_(sequence1, 0, sequence1.size(), sequence2, 0,
+                               sequence2.size(), minSimilarity);
+}
 }  // namespace tlo
 
 #endif  // TLO_CPP_DAMERAU_LEVENSHTEIN_HPP
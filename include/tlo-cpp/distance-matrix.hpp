@@ -0,0 +1,76 @@
+#ifndef TLO_CPP_DISTANCE_MATRIX_HPP
+#define TLO_CPP_DISTANCE_MATRIX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tlo-cpp/parallel.hpp"
+
+namespace tlo {
+// Returns the number of entries in the condensed upper triangle of the
+// distance matrix of numSequences sequences.
+std::size_t condensedSize(std::size_t numSequences);
+
+// Returns the position of the distance between sequences i and j (i < j) in
+// the condensed upper triangle of the distance matrix of numSequences
+// sequences. Entries are stored row by row: (0, 1), (0, 2), ..., (0, n-1),
+// (1, 2), ..., (n-2, n-1).
+std::size_t condensedIndex(std::size_t numSequences, std::size_t i,
+                           std::size_t j);
+
+namespace internal {
+// Number of sequences along each side of a tile of the distance matrix.
+constexpr std::size_t DISTANCE_MATRIX_TILE_SIZE = 16;
+}  // namespace internal
+
+// Returns the condensed upper triangle of the distance matrix of sequences,
+// where the distance between sequences i and j is
+// distance(sequences[i], sequences[j]). distance can be any callable, for
+// example a lambda calling levenshteinDistance3, damerLevenDistance2, or
+// lcsLength3. The matrix is cut into square tiles of sequences which are
+// distributed over numThreads threads (0 means defaultNumThreads()) with
+// parallelFor. Tiles sharing a row of tiles are adjacent in the task order so
+// each thread tends to keep the sequences of its row hot in cache. distance
+// must be safe to call concurrently.
+template <class CharSequence, class Distance>
+std::vector<std::invoke_result_t<Distance &, const CharSequence &,
+                                 const CharSequence &>>
+pairwiseDistances(const std::vector<CharSequence> &sequences,
+                  Distance distance, std::size_t numThreads = 0) {
+  using Result = std::invoke_result_t<Distance &, const CharSequence &,
+                                      const CharSequence &>;
+
+  const std::size_t numSequences = sequences.size();
+  const std::size_t tileSize = internal::DISTANCE_MATRIX_TILE_SIZE;
+  const std::size_t numTileRows = (numSequences + tileSize - 1) / tileSize;
+  std::vector<Result> distances(condensedSize(numSequences));
+  std::vector<std::pair<std::size_t, std::size_t>> tiles;
+
+  for (std::size_t tileRow = 0; tileRow < numTileRows; ++tileRow) {
+    for (std::size_t tileCol = tileRow; tileCol < numTileRows; ++tileCol) {
+      tiles.emplace_back(tileRow, tileCol);
+    }
+  }
+
+  parallelFor(tiles.size(), numThreads, [&](std::size_t tile) {
+    const std::size_t firstRow = tiles[tile].first * tileSize;
+    const std::size_t lastRow = std::min(firstRow + tileSize, numSequences);
+    const std::size_t firstCol = tiles[tile].second * tileSize;
+    const std::size_t lastCol = std::min(firstCol + tileSize, numSequences);
+
+    for (std::size_t i = firstRow; i < lastRow; ++i) {
+      for (std::size_t j = std::max(firstCol, i + 1); j < lastCol; ++j) {
+        distances[condensedIndex(numSequences, i, j)] =
+            distance(sequences[i], sequences[j]);
+      }
+    }
+  });
+
+  return distances;
+}
+}  // namespace tlo
+
+#endif  // TLO_CPP_DISTANCE_MATRIX_HPP
@@ -0,0 +1,66 @@
+#ifndef TLO_CPP_DP_TABLE_HPP
+#define TLO_CPP_DP_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace tlo {
+namespace internal {
+// Row-major numRows x numCols dynamic programming table stored in a single
+// contiguous buffer.
+template <class Cell>
+class DpTable {
+ private:
+  std::size_t numCols_;
+  std::vector<Cell> cells_;
+
+ public:
+  DpTable(std::size_t numRows, std::size_t numCols, Cell value = 0)
+      : numCols_(numCols), cells_(numRows * numCols, value) {}
+
+  // Like above but reuses the memory of storage. Get it back with release().
+  DpTable(std::size_t numRows, std::size_t numCols, std::vector<Cell> storage,
+          Cell value = 0)
+      : numCols_(numCols), cells_(std::move(storage)) {
+    cells_.assign(numRows * numCols, value);
+  }
+
+  Cell &operator()(std::size_t row, std::size_t col) {
+    return cells_[row * numCols_ + col];
+  }
+
+  const Cell &operator()(std::size_t row, std::size_t col) const {
+    return cells_[row * numCols_ + col];
+  }
+
+  // Returns the memory of the table, leaving the table empty.
+  std::vector<Cell> release() { return std::move(cells_); }
+};
+
+// Calls function with a value-initialized object of the narrowest of
+// std::uint8_t, std::uint16_t, std::uint32_t, and std::size_t that can hold
+// maxValue, and returns the result. Lets a table's cell type be chosen from the
+// sizes of the input sequences.
+template <class Function>
+auto withNarrowestCell(std::size_t maxValue, Function function) {
+  if (maxValue <= std::numeric_limits<std::uint8_t>::max()) {
+    return function(std::uint8_t{});
+  }
+
+  if (maxValue <= std::numeric_limits<std::uint16_t>::max()) {
+    return function(std::uint16_t{});
+  }
+
+  if (maxValue <= std::numeric_limits<std::uint32_t>::max()) {
+    return function(std::uint32_t{});
+  }
+
+  return function(std::size_t{});
+}
+}  // namespace internal
+}  // namespace tlo
+
+#endif  // TLO_CPP_DP_TABLE_HPP
@@ -0,0 +1,61 @@
+#ifndef TLO_CPP_EDIT_DISTANCE_WORKSPACE_HPP
+#define TLO_CPP_EDIT_DISTANCE_WORKSPACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace tlo {
+// Scratch buffers for the distance functions that take a workspace. Buffers
+// only ever grow, so once a workspace has seen the largest inputs, later calls
+// do not allocate. A workspace must only be used by one call at a time.
+class EditDistanceWorkspace {
+ private:
+  std::vector<std::size_t> row_;
+  std::vector<std::size_t> symbolRows_;
+  std::vector<std::uint32_t> ids1_;
+  std::vector<std::uint32_t> ids2_;
+  std::vector<std::uint8_t> cells8_;
+  std::vector<std::uint16_t> cells16_;
+  std::vector<std::uint32_t> cells32_;
+  std::vector<std::size_t> cellsWide_;
+
+ public:
+  // One row of a dynamic programming table.
+  std::vector<std::size_t> &row() { return row_; }
+
+  // The last row each symbol was seen in.
+  std::vector<std::size_t> &symbolRows() { return symbolRows_; }
+
+  // Dense symbol ids of the two sequences.
+  std::vector<std::uint32_t> &ids1() { return ids1_; }
+  std::vector<std::uint32_t> &ids2() { return ids2_; }
+
+  // Cells of a full dynamic programming table. Cell is one of the types
+  // internal::withNarrowestCell() chooses from.
+  template <class Cell>
+  std::vector<Cell> &cells() {
+    if constexpr (std::is_same_v<Cell, std::uint8_t>) {
+      return cells8_;
+    } else if constexpr (std::is_same_v<Cell, std::uint16_t>) {
+      return cells16_;
+    } else if constexpr (std::is_same_v<Cell, std::uint32_t>) {
+      return cells32_;
+    } else {
+      static_assert(std::is_same_v<Cell, std::size_t>);
+      return cellsWide_;
+    }
+  }
+
+  // Frees all buffers.
+  void release();
+
+  // Returns the workspace of the calling thread that the distance functions
+  // use when not given one. Its buffers live as long as the thread, so call
+  // release() on it after an unusually large comparison.
+  static EditDistanceWorkspace &threadLocal();
+};
+}  // namespace tlo
+
+#endif  // TLO_CPP_EDIT_DISTANCE_WORKSPACE_HPP
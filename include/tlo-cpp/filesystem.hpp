@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <ctime>
 #include <filesystem>
+#include <istream>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -17,6 +19,29 @@ std::uintmax_t getFileSize(const std::filesystem::path &filePath);
 
 std::time_t getLastWriteTime(const std::filesystem::path &path);
 
+// Reads istream to the end in chunks of at most chunkSize chars and calls
+// function(const char *chunk, std::size_t size) on each one, reusing a single
+// buffer. Throws std::runtime_error if reading fails before the end.
+template <class Function>
+void forEachChunk(std::istream &istream, std::size_t chunkSize,
+                  Function function) {
+  std::vector<char> buffer(chunkSize);
+
+  while (istream) {
+    istream.read(buffer.data(), static_cast<std::streamsize>(chunkSize));
+
+    auto numRead = static_cast<std::size_t>(istream.gcount());
+
+    if (numRead > 0) {
+      function(buffer.data(), numRead);
+    }
+  }
+
+  if (istream.bad()) {
+    throw std::runtime_error("Error: Failed to read stream.");
+  }
+}
+
 struct HashPath {
   std::size_t operator()(const std::filesystem::path &path) const;
 };
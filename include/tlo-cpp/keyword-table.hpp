@@ -0,0 +1,130 @@
+#ifndef TLO_CPP_KEYWORD_TABLE_HPP
+#define TLO_CPP_KEYWORD_TABLE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+#include "tlo-cpp/levenshtein.hpp"
+
+namespace tlo {
+struct KeywordMatch {
+  // Index of the keyword in the table.
+  std::size_t index;
+
+  // Levenshtein distance between the input and the keyword.
+  std::size_t distance;
+};
+
+// A fixed set of NUM_KEYWORDS keywords of at most CAPACITY characters each,
+// with the Levenshtein distance between every pair of them computed in the
+// constructor. Declared constexpr, the whole table is built by the compiler.
+// nearest() uses the table to skip keywords by the triangle inequality, and
+// folds away completely when the input is itself a constant. The keywords must
+// outlive this, which string literals do.
+template <std::size_t NUM_KEYWORDS, std::size_t CAPACITY = 64>
+class KeywordTable {
+ private:
+  std::array<std::string_view, NUM_KEYWORDS> keywords_;
+  std::array<std::array<std::size_t, NUM_KEYWORDS>, NUM_KEYWORDS> distances_{};
+
+  static constexpr std::size_t absoluteDifference(std::size_t a,
+                                                  std::size_t b) {
+    return a < b ? b - a : a - b;
+  }
+
+ public:
+  // Throws std::length_error if a keyword is longer than CAPACITY, which fails
+  // compilation in a constant expression.
+  constexpr explicit KeywordTable(
+      const std::array<std::string_view, NUM_KEYWORDS> &keywords)
+      : keywords_(keywords) {
+    for (std::size_t i = 0; i < NUM_KEYWORDS; ++i) {
+      if (keywords_[i].size() > CAPACITY) {
+        throw std::length_error("Error: Keyword is too long for KeywordTable.");
+      }
+
+      for (std::size_t j = 0; j < i; ++j) {
+        distances_[i][j] =
+            levenshteinDistanceFixed<CAPACITY>(keywords_[i], keywords_[j]);
+        distances_[j][i] = distances_[i][j];
+      }
+    }
+  }
+
+  constexpr std::size_t size() const { return NUM_KEYWORDS; }
+
+  constexpr std::string_view keyword(std::size_t index) const {
+    assert(index < NUM_KEYWORDS);
+    return keywords_[index];
+  }
+
+  // Returns the Levenshtein distance between the keywords with given indexes.
+  constexpr std::size_t distance(std::size_t index1,
+                                 std::size_t index2) const {
+    assert(index1 < NUM_KEYWORDS && index2 < NUM_KEYWORDS);
+    return distances_[index1][index2];
+  }
+
+  // Returns the keyword closest to input by Levenshtein distance, the one with
+  // the lowest index on ties. A keyword is only compared with input if neither
+  // the difference in size nor |d(input, k) - d(k, keyword)| for any keyword k
+  // compared so far rules out that it is closer than the best one so far.
+  // Input may be longer than CAPACITY.
+  constexpr KeywordMatch nearest(std::string_view input) const {
+    static_assert(NUM_KEYWORDS > 0, "KeywordTable has no keywords.");
+
+    // The keywords compared so far and their distances to input.
+    std::array<KeywordMatch, NUM_KEYWORDS> compared{};
+    std::size_t numCompared = 0;
+    KeywordMatch best{0, std::numeric_limits<std::size_t>::max()};
+
+    for (std::size_t i = 0; i < NUM_KEYWORDS; ++i) {
+      std::size_t lowerBound = absoluteDifference(input.size(),
+                                                  keywords_[i].size());
+
+      for (std::size_t k = 0; k < numCompared && lowerBound < best.distance;
+           ++k) {
+        lowerBound = std::max(
+            lowerBound, absoluteDifference(compared[k].distance,
+                                           distances_[compared[k].index][i]));
+      }
+
+      if (lowerBound >= best.distance) {
+        continue;
+      }
+
+      std::size_t inputDistance =
+          levenshteinDistanceFixed<CAPACITY>(input, keywords_[i]);
+
+      compared[numCompared++] = {i, inputDistance};
+
+      if (inputDistance < best.distance) {
+        best = {i, inputDistance};
+      }
+    }
+
+    return best;
+  }
+};
+
+// Returns a KeywordTable of the given keywords, deducing their number, e.g.
+// constexpr auto table = makeKeywordTable({"add"sv, "commit"sv, "push"sv}).
+template <std::size_t CAPACITY = 64, std::size_t NUM_KEYWORDS>
+constexpr KeywordTable<NUM_KEYWORDS, CAPACITY> makeKeywordTable(
+    const std::string_view (&keywords)[NUM_KEYWORDS]) {
+  std::array<std::string_view, NUM_KEYWORDS> array{};
+
+  for (std::size_t i = 0; i < NUM_KEYWORDS; ++i) {
+    array[i] = keywords[i];
+  }
+
+  return KeywordTable<NUM_KEYWORDS, CAPACITY>(array);
+}
+}  // namespace tlo
+
+#endif  // TLO_CPP_KEYWORD_TABLE_HPP
@@ -2,11 +2,23 @@
 #define TLO_CPP_LCS_HPP
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <ostream>
+#include <stdexcept>
 #include <vector>
 
+#include "tlo-cpp/anti-diagonal.hpp"
+#include "tlo-cpp/bit-parallel.hpp"
+#include "tlo-cpp/common-affixes.hpp"
+#include "tlo-cpp/dp-table.hpp"
+#include "tlo-cpp/edit-distance-workspace.hpp"
+#include "tlo-cpp/similarity.hpp"
+#include "tlo-cpp/wavefront.hpp"
+
 #ifdef TLO_CPP_DEBUG_LLCS
 #include <iostream>
 #endif
@@ -29,26 +41,18 @@ std::size_t lcsDistance(std::size_t size1, std::size_t size2,
                         std::size_t lcsLength);
 }  // namespace internal
 
-// Returns the length of the LCS of sequence1[startIndex1, startIndex1+size1)
-// and sequence2[startIndex2, startIndex2+size2). Takes O(size1 * size2) time.
-// Uses O(size1 * size2) memory.
-template <class CharSequence>
-LcsLengthResult lcsLength1_(const CharSequence &sequence1,
-                            std::size_t startIndex1, std::size_t size1,
-                            const CharSequence &sequence2,
-                            std::size_t startIndex2, std::size_t size2) {
-  assert(startIndex1 + size1 <= sequence1.size());
-  assert(startIndex2 + size2 <= sequence2.size());
-
-  if (size1 == 0 || size2 == 0) {
-    return {0, internal::lcsDistance(size1, size2, 0)};
-  }
-
-  // lcsLengths[m][n] will store the length of the LCS of
+namespace internal {
+// Implements lcsLength1_ using a table of Cell. Cell must be able to hold
+// min(size1, size2).
+template <class Cell, class CharSequence>
+std::size_t lcsLength1WithCells(const CharSequence &sequence1,
+                                std::size_t startIndex1, std::size_t size1,
+                                const CharSequence &sequence2,
+                                std::size_t startIndex2, std::size_t size2) {
+  // lcsLengths(m, n) will store the length of the LCS of
   // sequence1[startIndex1, startIndex1+m) and
   // sequence2[startIndex2, startIndex2+n).
-  std::vector<std::vector<std::size_t>> lcsLengths(
-      size1 + 1, std::vector<std::size_t>(size2 + 1, 0));
+  DpTable<Cell> lcsLengths(size1 + 1, size2 + 1);
 
   for (std::size_t i = 0; i < size1; ++i) {
     std::size_t row = i + 1;
@@ -57,10 +61,11 @@ LcsLengthResult lcsLength1_(const CharSequence &sequence1,
       std::size_t col = j + 1;
 
       if (sequence1[startIndex1 + i] == sequence2[startIndex2 + j]) {
-        lcsLengths[row][col] = lcsLengths[row - 1][col - 1] + 1;
+        lcsLengths(row, col) =
+            static_cast<Cell>(lcsLengths(row - 1, col - 1) + 1);
       } else {
-        lcsLengths[row][col] =
-            std::max(lcsLengths[row][col - 1], lcsLengths[row - 1][col]);
+        lcsLengths(row, col) =
+            std::max(lcsLengths(row, col - 1), lcsLengths(row - 1, col));
       }
     }
   }
@@ -69,15 +74,39 @@ LcsLengthResult lcsLength1_(const CharSequence &sequence1,
   std::cerr << __func__ << " lcsLengths:" << std::endl;
   for (std::size_t i = 0; i <= size1; ++i) {
     for (std::size_t j = 0; j <= size2; ++j) {
-      std::cerr << lcsLengths[i][j] << " ";
+      std::cerr << std::size_t{lcsLengths(i, j)} << " ";
     }
     std::cerr << std::endl;
   }
 #endif
 
+  return lcsLengths(size1, size2);
+}
+}  // namespace internal
+
+// Returns the length of the LCS of sequence1[startIndex1, startIndex1+size1)
+// and sequence2[startIndex2, startIndex2+size2). Takes O(size1 * size2) time.
+// Uses O(size1 * size2) memory in a single contiguous table whose cells are the
+// narrowest unsigned integers that can hold min(size1, size2).
+template <class CharSequence>
+LcsLengthResult lcsLength1_(const CharSequence &sequence1,
+                            std::size_t startIndex1, std::size_t size1,
+                            const CharSequence &sequence2,
+                            std::size_t startIndex2, std::size_t size2) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  if (size1 == 0 || size2 == 0) {
+    return {0, internal::lcsDistance(size1, size2, 0)};
+  }
+
   LcsLengthResult result;
 
-  result.lcsLength = lcsLengths[size1][size2];
+  result.lcsLength = internal::withNarrowestCell(
+      std::min(size1, size2), [&](auto cell) {
+        return internal::lcsLength1WithCells<decltype(cell)>(
+            sequence1, startIndex1, size1, sequence2, startIndex2, size2);
+      });
   result.lcsDistance = internal::lcsDistance(size1, size2, result.lcsLength);
   return result;
 }
@@ -89,17 +118,73 @@ LcsLengthResult lcsLength1(const CharSequence &sequence1,
                      sequence2.size());
 }
 
+namespace internal {
+// Advances lcsLengths from the row of the table of lcsLastRow for some prefix
+// of sequence1 to the row for that prefix followed by charInSeq1. Takes
+// O(size2) time.
+template <bool REVERSE, class CharSequence, class Char>
+void lcsNextRow(const Char &charInSeq1, const CharSequence &sequence2,
+                std::size_t startIndex2, std::size_t size2,
+                std::vector<std::size_t> &lcsLengths) {
+  assert(lcsLengths.size() == size2 + 1);
+
+  std::size_t valueInPreviousColumnBeforeUpdate = 0;
+
+  for (std::size_t j = 0; j < size2; ++j) {
+    std::size_t col = j + 1;
+    std::size_t valueInColumnBeforeUpdate = lcsLengths[col];
+
+    // lcsLengths[row - 1][col - 1] -> valueInPreviousColumnBeforeUpdate.
+    // lcsLengths[row][col - 1] -> lcsLengths[col - 1].
+    // lcsLengths[row - 1][col] -> lcsLengths[col].
+    if (charInSeq1 ==
+        sequence2[REVERSE ? startIndex2 + size2 - 1 - j : startIndex2 + j]) {
+      lcsLengths[col] = valueInPreviousColumnBeforeUpdate + 1;
+    } else {
+      lcsLengths[col] = std::max(lcsLengths[col - 1], lcsLengths[col]);
+    }
+
+    valueInPreviousColumnBeforeUpdate = valueInColumnBeforeUpdate;
+  }
+}
+
+// Sets lcsLengths[n] to the length of the LCS of
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+n) for every n in [0, size2]. That is the
+// last row of the table of lcsLength1_. If REVERSE is true, both ranges are
+// read back to front, so lcsLengths[n] is instead the length of the LCS of
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2+size2-n, startIndex2+size2). Takes O(size1 * size2)
+// time. Uses only the O(size2) memory of lcsLengths.
+template <bool REVERSE, class CharSequence>
+void lcsLastRow(const CharSequence &sequence1, std::size_t startIndex1,
+                std::size_t size1, const CharSequence &sequence2,
+                std::size_t startIndex2, std::size_t size2,
+                std::vector<std::size_t> &lcsLengths) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  lcsLengths.assign(size2 + 1, 0);
+
+  for (std::size_t i = 0; i < size1; ++i) {
+    lcsNextRow<REVERSE>(
+        sequence1[REVERSE ? startIndex1 + size1 - 1 - i : startIndex1 + i],
+        sequence2, startIndex2, size2, lcsLengths);
+  }
+}
+}  // namespace internal
+
 // Returns the length of the LCS of sequence1[startIndex1, startIndex1+size1)
 // and sequence2[startIndex2, startIndex2+size2). Takes O(size1 * size2) time.
-// Uses only O(min(size1, size2)) memory.
+// Uses only O(min(size1, size2)) memory, which comes from workspace.
 template <class CharSequence>
-LcsLengthResult lcsLength2_(const CharSequence &sequence1,
-                            std::size_t startIndex1, std::size_t size1,
-                            const CharSequence &sequence2,
-                            std::size_t startIndex2, std::size_t size2) {
+LcsLengthResult lcsLength2WithWorkspace_(
+    const CharSequence &sequence1, std::size_t startIndex1, std::size_t size1,
+    const CharSequence &sequence2, std::size_t startIndex2, std::size_t size2,
+    EditDistanceWorkspace &workspace) {
   if (size1 < size2) {
-    return lcsLength2_(sequence2, startIndex2, size2, sequence1, startIndex1,
-                       size1);
+    return lcsLength2WithWorkspace_(sequence2, startIndex2, size2, sequence1,
+                                    startIndex1, size1, workspace);
   }
 
   assert(startIndex1 + size1 <= sequence1.size());
@@ -113,19 +198,83 @@ LcsLengthResult lcsLength2_(const CharSequence &sequence1,
   // lcsLengths[n] will store the length of the LCS of
   // sequence1[startIndex1, startIndex1+size1) and
   // sequence2[startIndex2, startIndex2+n).
-  std::vector<std::size_t> lcsLengths(size2 + 1, 0);
+  std::vector<std::size_t> &lcsLengths = workspace.row();
+
+  internal::lcsLastRow<false>(sequence1, startIndex1, size1, sequence2,
+                              startIndex2, size2, lcsLengths);
+
+#ifdef TLO_CPP_DEBUG_LLCS
+  std::cerr << __func__ << " lcsLengths:" << std::endl;
+  for (std::size_t j = 0; j <= size2; ++j) {
+    std::cerr << lcsLengths[j] << " ";
+  }
+  std::cerr << std::endl;
+#endif
+
+  LcsLengthResult result;
+
+  result.lcsLength = lcsLengths[size2];
+  result.lcsDistance = internal::lcsDistance(size1, size2, result.lcsLength);
+  return result;
+}
+
+// Like lcsLength2WithWorkspace_ but uses the workspace of the calling thread.
+template <class CharSequence>
+LcsLengthResult lcsLength2_(const CharSequence &sequence1,
+                            std::size_t startIndex1, std::size_t size1,
+                            const CharSequence &sequence2,
+                            std::size_t startIndex2, std::size_t size2) {
+  return lcsLength2WithWorkspace_(sequence1, startIndex1, size1, sequence2,
+                                  startIndex2, size2,
+                                  EditDistanceWorkspace::threadLocal());
+}
+
+template <class CharSequence>
+LcsLengthResult lcsLength2(const CharSequence &sequence1,
+                           const CharSequence &sequence2) {
+  return lcsLength2_(sequence1, 0, sequence1.size(), sequence2, 0,
+                     sequence2.size());
+}
+
+// Returns the length of the LCS of sequence1[startIndex1, startIndex1+size1)
+// and sequence2[startIndex2, startIndex2+size2). Runs the row loop of
+// lcsLength2_ over a std::array of CAPACITY + 1 cells instead of a
+// heap-allocated row, so it can be evaluated at compile time, e.g. on
+// std::string_view or std::array. Throws std::length_error if
+// min(size1, size2) > CAPACITY, which fails compilation in a constant
+// expression. Takes O(size1 * size2) time.
+template <std::size_t CAPACITY, class CharSequence>
+constexpr LcsLengthResult lcsLengthFixed_(const CharSequence &sequence1,
+                                          std::size_t startIndex1,
+                                          std::size_t size1,
+                                          const CharSequence &sequence2,
+                                          std::size_t startIndex2,
+                                          std::size_t size2) {
+  if (size1 < size2) {
+    return lcsLengthFixed_<CAPACITY>(sequence2, startIndex2, size2, sequence1,
+                                     startIndex1, size1);
+  }
+
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+  assert(size2 <= size1);
+
+  if (size2 > CAPACITY) {
+    throw std::length_error(
+        "Error: Sequences are too long for lcsLengthFixed_.");
+  }
+
+  std::array<std::size_t, CAPACITY + 1> lcsLengths{};
 
   for (std::size_t i = 0; i < size1; ++i) {
+    const auto &charInSeq1 = sequence1[startIndex1 + i];
     std::size_t valueInPreviousColumnBeforeUpdate = 0;
 
     for (std::size_t j = 0; j < size2; ++j) {
       std::size_t col = j + 1;
       std::size_t valueInColumnBeforeUpdate = lcsLengths[col];
 
-      // lcsLengths[row - 1][col - 1] -> valueInPreviousColumnBeforeUpdate.
-      // lcsLengths[row][col - 1] -> lcsLengths[col - 1].
-      // lcsLengths[row - 1][col] -> lcsLengths[col].
-      if (sequence1[startIndex1 + i] == sequence2[startIndex2 + j]) {
+      if (charInSeq1 == sequence2[startIndex2 + j]) {
         lcsLengths[col] = valueInPreviousColumnBeforeUpdate + 1;
       } else {
         lcsLengths[col] = std::max(lcsLengths[col - 1], lcsLengths[col]);
@@ -135,75 +284,456 @@ LcsLengthResult lcsLength2_(const CharSequence &sequence1,
     }
   }
 
-#ifdef TLO_CPP_DEBUG_LLCS
-  std::cerr << __func__ << " lcsLengths:" << std::endl;
-  for (std::size_t j = 0; j <= size2; ++j) {
-    std::cerr << lcsLengths[j] << " ";
+  // internal::lcsDistance is not constexpr, so compute it inline.
+  return {lcsLengths[size2], size1 + size2 - 2 * lcsLengths[size2]};
+}
+
+template <std::size_t CAPACITY, class CharSequence>
+constexpr LcsLengthResult lcsLengthFixed(const CharSequence &sequence1,
+                                         const CharSequence &sequence2) {
+  return lcsLengthFixed_<CAPACITY>(sequence1, 0, sequence1.size(), sequence2,
+                                   0, sequence2.size());
+}
+
+// Returns the length of the LCS of sequence1[startIndex1, startIndex1+size1)
+// and sequence2[startIndex2, startIndex2+size2). Computes the same table as
+// lcsLength2_, with tiles of tileSize cells on each anti-diagonal of tiles
+// computed concurrently by numThreads threads (0 means defaultNumThreads()).
+// See internal::wavefront. Only pays off when both sequences are many tiles
+// long. Takes O(size1 * size2) time. Uses O(size1 + size2) memory.
+template <class CharSequence>
+LcsLengthResult lcsLengthWavefrontWithThreads_(
+    const CharSequence &sequence1, std::size_t startIndex1, std::size_t size1,
+    const CharSequence &sequence2, std::size_t startIndex2, std::size_t size2,
+    std::size_t numThreads,
+    std::size_t tileSize = internal::WAVEFRONT_TILE_SIZE) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  if (size1 == 0 || size2 == 0) {
+    return {0, internal::lcsDistance(size1, size2, 0)};
   }
-  std::cerr << std::endl;
-#endif
+
+  std::vector<std::size_t> top(size2 + 1, 0);
+  std::vector<std::size_t> left(size1 + 1, 0);
+
+  internal::wavefront(
+      sequence1, startIndex1, size1, sequence2, startIndex2, size2, top, left,
+      numThreads, tileSize,
+      [](std::size_t upperLeft, std::size_t upper, std::size_t leftCell,
+         bool isMatch) {
+        return isMatch ? upperLeft + 1 : std::max(upper, leftCell);
+      });
 
   LcsLengthResult result;
 
-  result.lcsLength = lcsLengths[size2];
+  result.lcsLength = top[size2];
   result.lcsDistance = internal::lcsDistance(size1, size2, result.lcsLength);
   return result;
 }
 
+// Like lcsLengthWavefrontWithThreads_ but uses defaultNumThreads() threads.
+// Can be used as the lcsLength of lcsLength3_.
 template <class CharSequence>
-LcsLengthResult lcsLength2(const CharSequence &sequence1,
-                           const CharSequence &sequence2) {
-  return lcsLength2_(sequence1, 0, sequence1.size(), sequence2, 0,
-                     sequence2.size());
+LcsLengthResult lcsLengthWavefront_(const CharSequence &sequence1,
+                                    std::size_t startIndex1, std::size_t size1,
+                                    const CharSequence &sequence2,
+                                    std::size_t startIndex2,
+                                    std::size_t size2) {
+  return lcsLengthWavefrontWithThreads_(sequence1, startIndex1, size1,
+                                        sequence2, startIndex2, size2, 0);
+}
+
+template <class CharSequence>
+LcsLengthResult lcsLengthWavefront(const CharSequence &sequence1,
+                                   const CharSequence &sequence2) {
+  return lcsLengthWavefront_(sequence1, 0, sequence1.size(), sequence2, 0,
+                             sequence2.size());
 }
 
+// Computes the LCS of sequence2[startIndex2, startIndex2+size2) and a sequence
+// whose elements are pushed one row of the table at a time, e.g. as chunks are
+// read from a stream. Only one row is kept, so memory is O(size2) however long
+// the pushed sequence grows, and each pushed element takes O(size2) time.
+// sequence2 must outlive this.
+template <class CharSequence>
+class LcsRowStream {
+ private:
+  const CharSequence *sequence2_;
+  std::size_t startIndex2_;
+  std::size_t size2_;
+  std::size_t size1_ = 0;
+  std::vector<std::size_t> lcsLengths_;
+
+ public:
+  LcsRowStream(const CharSequence &sequence2, std::size_t startIndex2,
+               std::size_t size2)
+      : sequence2_(&sequence2),
+        startIndex2_(startIndex2),
+        size2_(size2),
+        lcsLengths_(size2 + 1, 0) {
+    assert(startIndex2 + size2 <= sequence2.size());
+  }
+
+  explicit LcsRowStream(const CharSequence &sequence2)
+      : LcsRowStream(sequence2, 0, sequence2.size()) {}
+
+  template <class Char>
+  void push(const Char &charInSeq1) {
+    internal::lcsNextRow<false>(charInSeq1, *sequence2_, startIndex2_, size2_,
+                                lcsLengths_);
+    ++size1_;
+  }
+
+  template <class Iterator>
+  void push(Iterator first, Iterator last) {
+    for (; first != last; ++first) {
+      push(*first);
+    }
+  }
+
+  // Returns the number of elements pushed so far.
+  std::size_t size1() const { return size1_; }
+
+  // Returns the LCS length and LCS distance between the elements pushed so far
+  // and sequence2[startIndex2, startIndex2+size2).
+  LcsLengthResult result() const {
+    return {lcsLengths_[size2_],
+            internal::lcsDistance(size1_, size2_, lcsLengths_[size2_])};
+  }
+};
+
 // Returns the length of the LCS of sequence1[startIndex1, startIndex1+size1)
-// and sequence2[startIndex2, startIndex2+size2). Does additional optimizations
-// on top of one of the other lcsLength functions.
+// and sequence2[startIndex2, startIndex2+size2). Evaluates the recurrence of
+// lcsLength1_ along anti-diagonals with SSE4.1 or AVX2 (selected at runtime)
+// using the narrowest of 8-, 16-, or 32-bit lanes that can hold
+// min(size1, size2). Falls back to lcsLength2_ if the elements of CharSequence
+// are not bytes, if the CPU supports neither instruction set, or if the
+// sequences are too long for 32-bit lanes. Takes O(size1 * size2) time. Uses
+// O(size1 + size2) memory.
 template <class CharSequence>
-LcsLengthResult lcsLength3_(
-    const CharSequence &sequence1, std::size_t startIndex1, std::size_t size1,
-    const CharSequence &sequence2, std::size_t startIndex2, std::size_t size2,
-    LcsLengthResult (*lcsLength)(const CharSequence &, std::size_t, std::size_t,
-                                 const CharSequence &, std::size_t,
-                                 std::size_t) = lcsLength2_<CharSequence>) {
+LcsLengthResult lcsLengthSimd_(const CharSequence &sequence1,
+                               std::size_t startIndex1, std::size_t size1,
+                               const CharSequence &sequence2,
+                               std::size_t startIndex2, std::size_t size2) {
+  if (size1 > size2) {
+    return lcsLengthSimd_(sequence2, startIndex2, size2, sequence1,
+                          startIndex1, size1);
+  }
+
   assert(startIndex1 + size1 <= sequence1.size());
   assert(startIndex2 + size2 <= sequence2.size());
+  assert(size1 <= size2);
 
   if (size1 == 0 || size2 == 0) {
     return {0, internal::lcsDistance(size1, size2, 0)};
   }
 
-  std::size_t prefixLength = 0;
+  if constexpr (sizeof(internal::CharOf<CharSequence>) == 1) {
+    const internal::SimdLevel level = internal::simdLevel();
+
+    if (level != internal::SimdLevel::NONE &&
+        size1 < std::numeric_limits<std::uint32_t>::max()) {
+      // Diagonals are indexed by positions in the shorter sequence1.
+      std::vector<unsigned char> bytes1 =
+          internal::toAntiDiagonalBytes(sequence1, startIndex1, size1, false);
+      std::vector<unsigned char> reversedBytes2 =
+          internal::toAntiDiagonalBytes(sequence2, startIndex2, size2, true);
+      LcsLengthResult result;
+
+      result.lcsLength = internal::lcsLengthAntiDiagonal(
+          level, bytes1.data(), size1, reversedBytes2.data(), size2);
+      result.lcsDistance =
+          internal::lcsDistance(size1, size2, result.lcsLength);
+      return result;
+    }
+  }
+
+  return lcsLength2_(sequence1, startIndex1, size1, sequence2, startIndex2,
+                     size2);
+}
+
+template <class CharSequence>
+LcsLengthResult lcsLengthSimd(const CharSequence &sequence1,
+                              const CharSequence &sequence2) {
+  return lcsLengthSimd_(sequence1, 0, sequence1.size(), sequence2, 0,
+                        sequence2.size());
+}
 
-  for (std::size_t i = 0; i < size1 && i < size2; ++i) {
-    if (sequence1[startIndex1 + i] != sequence2[startIndex2 + i]) {
-      break;
+namespace internal {
+// Returns the length of the LCS of the pattern described by
+// patternMatchVectors and text[startIndex, startIndex+size). Keeps one bit per
+// pattern position, cleared where the LCS of the pattern prefix and the text
+// prefix grows, and updates it one text element at a time with an addition
+// whose carries cross block boundaries. Based on "A Bit-String
+// Longest-Common-Subsequence Algorithm" by Lloyd Allison and Trevor Dix and
+// "Bit-Parallel LCS-length Computation Revisited" by Heikki Hyyro. rows is a
+// scratch buffer.
+template <class CharSequence, class Char>
+std::size_t lcsLengthBitParallel(
+    const PatternMatchVectors<Char> &patternMatchVectors,
+    const CharSequence &text, std::size_t startIndex, std::size_t size,
+    std::vector<Word> &rows) {
+  assert(startIndex + size <= text.size());
+
+  const std::size_t numBlocks = patternMatchVectors.numBlocks();
+
+  // Bits past the end of the pattern never match, so they stay set and do not
+  // count towards the LCS length.
+  if (numBlocks == 1) {
+    Word row = ~Word{0};
+
+    for (std::size_t i = 0; i < size; ++i) {
+      Word matches = *patternMatchVectors.get(text[startIndex + i]);
+
+      row = (row + (row & matches)) | (row & ~matches);
     }
 
-    prefixLength++;
+    return popCount(~row);
   }
 
-  std::size_t smallerSize = std::min(size1, size2);
+  rows.assign(numBlocks, ~Word{0});
 
-  if (prefixLength == smallerSize) {
-    return {prefixLength, internal::lcsDistance(size1, size2, prefixLength)};
+  for (std::size_t i = 0; i < size; ++i) {
+    const Word *matches = patternMatchVectors.get(text[startIndex + i]);
+    Word carry = 0;
+
+    for (std::size_t block = 0; block < numBlocks; ++block) {
+      Word row = rows[block];
+      Word sum = row + (row & matches[block]);
+      Word sumWithCarry = sum + carry;
+
+      carry = (sum < row || sumWithCarry < sum) ? Word{1} : Word{0};
+      rows[block] = sumWithCarry | (row & ~matches[block]);
+    }
   }
 
-  std::size_t remainingLength = smallerSize - prefixLength;
-  std::size_t suffixLength = 0;
+  std::size_t lcsLength = 0;
+
+  for (Word row : rows) {
+    lcsLength += popCount(~row);
+  }
+
+  return lcsLength;
+}
+}  // namespace internal
+
+// Returns the length of the LCS of sequence1[startIndex1, startIndex1+size1)
+// and sequence2[startIndex2, startIndex2+size2). Uses the bit-vector algorithm
+// of Allison-Dix and Hyyro with the shorter sequence as the pattern. Takes
+// O(ceil(min(size1, size2) / 64) * max(size1, size2)) time. Uses
+// O(ceil(min(size1, size2) / 64)) memory plus a table of bit vectors for the
+// alphabet of the shorter sequence.
+template <class CharSequence>
+LcsLengthResult lcsLengthBitParallel_(const CharSequence &sequence1,
+                                      std::size_t startIndex1,
+                                      std::size_t size1,
+                                      const CharSequence &sequence2,
+                                      std::size_t startIndex2,
+                                      std::size_t size2) {
+  if (size1 < size2) {
+    return lcsLengthBitParallel_(sequence2, startIndex2, size2, sequence1,
+                                 startIndex1, size1);
+  }
+
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+  assert(size2 <= size1);
+
+  if (size1 == 0 || size2 == 0) {
+    return {0, internal::lcsDistance(size1, size2, 0)};
+  }
+
+  internal::PatternMatchVectors<internal::CharOf<CharSequence>>
+      patternMatchVectors;
+  std::vector<internal::Word> rows;
+  LcsLengthResult result;
+
+  patternMatchVectors.assign(sequence2, startIndex2, size2);
+  result.lcsLength = internal::lcsLengthBitParallel(
+      patternMatchVectors, sequence1, startIndex1, size1, rows);
+  result.lcsDistance = internal::lcsDistance(size1, size2, result.lcsLength);
+  return result;
+}
+
+template <class CharSequence>
+LcsLengthResult lcsLengthBitParallel(const CharSequence &sequence1,
+                                     const CharSequence &sequence2) {
+  return lcsLengthBitParallel_(sequence1, 0, sequence1.size(), sequence2, 0,
+                               sequence2.size());
+}
 
-  for (std::size_t i = size1 - 1, j = size2 - 1; i < size1 && j < size2;
-       --i, --j) {
-    if (sequence1[startIndex1 + i] != sequence2[startIndex2 + j]) {
-      break;
+namespace internal {
+// Returns the LCS distance D of sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2) with Myers' greedy algorithm. For
+// each number of edits d, it extends the furthest reaching path on every
+// diagonal k = x - y, both forward from the start and backward from the end,
+// until a forward and a backward path overlap (the middle snake). Each search
+// only goes about D/2 edits deep and keeps one x per diagonal.
+template <class CharSequence>
+std::size_t lcsDistanceMyersOnd(const CharSequence &sequence1,
+                                std::size_t startIndex1, std::size_t size1,
+                                const CharSequence &sequence2,
+                                std::size_t startIndex2, std::size_t size2) {
+  using Index = std::ptrdiff_t;
+
+  const Index n = static_cast<Index>(size1);
+  const Index m = static_cast<Index>(size2);
+  const Index delta = n - m;
+  const bool deltaIsOdd = (size1 + size2) % 2 == 1;
+  const Index maxD = (n + m + 1) / 2;
+  const Index offset = maxD + 1;
+
+  // forward[offset + k] is the furthest x reached on diagonal k from (0, 0).
+  // backward[offset + k] is the same for the reversed sequences, so
+  // backward[offset + k] == x stands for the point (n - x, m - x + k). -1
+  // means not reached yet.
+  std::vector<Index> forward(static_cast<std::size_t>(2 * offset + 1), -1);
+  std::vector<Index> backward(forward.size(), -1);
+
+  // Diagonals at the ends of the range that have left the grid and are no
+  // longer extended.
+  Index forwardStart = 0;
+  Index forwardEnd = 0;
+  Index backwardStart = 0;
+  Index backwardEnd = 0;
+
+  const auto at = [offset](std::vector<Index> &furthest, Index k) -> Index & {
+    return furthest[static_cast<std::size_t>(offset + k)];
+  };
+  const auto isInGrid = [n, m](Index x, Index k) {
+    return x >= 0 && x <= n && x - k >= 0 && x - k <= m;
+  };
+  const auto next = [&at](std::vector<Index> &furthest, Index k, Index d) {
+    if (k == -d || (k != d && at(furthest, k - 1) < at(furthest, k + 1))) {
+      return at(furthest, k + 1);
     }
 
-    if (suffixLength == remainingLength) {
-      break;
+    return at(furthest, k - 1) + 1;
+  };
+
+  at(forward, 1) = 0;
+  at(backward, 1) = 0;
+
+  for (Index d = 0; d <= maxD; ++d) {
+    for (Index k = -d + forwardStart; k <= d - forwardEnd; k += 2) {
+      Index x = next(forward, k, d);
+      Index y = x - k;
+
+      while (x < n && y < m &&
+             sequence1[startIndex1 + static_cast<std::size_t>(x)] ==
+                 sequence2[startIndex2 + static_cast<std::size_t>(y)]) {
+        ++x;
+        ++y;
+      }
+
+      at(forward, k) = x;
+
+      if (x > n) {
+        forwardEnd += 2;
+      } else if (y > m) {
+        forwardStart += 2;
+      } else if (deltaIsOdd && delta - k >= -(d - 1) && delta - k <= d - 1) {
+        Index backwardX = at(backward, delta - k);
+
+        if (isInGrid(backwardX, delta - k) && x + backwardX >= n) {
+          return static_cast<std::size_t>(2 * d - 1);
+        }
+      }
     }
 
-    suffixLength++;
+    for (Index k = -d + backwardStart; k <= d - backwardEnd; k += 2) {
+      Index x = next(backward, k, d);
+      Index y = x - k;
+
+      while (x < n && y < m &&
+             sequence1[startIndex1 + size1 - 1 - static_cast<std::size_t>(x)] ==
+                 sequence2[startIndex2 + size2 - 1 -
+                           static_cast<std::size_t>(y)]) {
+        ++x;
+        ++y;
+      }
+
+      at(backward, k) = x;
+
+      if (x > n) {
+        backwardEnd += 2;
+      } else if (y > m) {
+        backwardStart += 2;
+      } else if (!deltaIsOdd && delta - k >= -d && delta - k <= d) {
+        Index forwardX = at(forward, delta - k);
+
+        if (isInGrid(forwardX, delta - k) && x + forwardX >= n) {
+          return static_cast<std::size_t>(2 * d);
+        }
+      }
+    }
+  }
+
+  assert(false);
+  return size1 + size2;
+}
+}  // namespace internal
+
+// Returns the length of the LCS of sequence1[startIndex1, startIndex1+size1)
+// and sequence2[startIndex2, startIndex2+size2). Uses Myers' O(ND) algorithm
+// with a bidirectional middle snake search, so it is fast when the sequences
+// are similar, e.g. revisions of a file compared as vectors of line hashes.
+// Only needs == on the elements of CharSequence. Takes
+// O((size1 + size2) * D) time, where D is the LCS distance. Uses
+// O(size1 + size2) memory.
+template <class CharSequence>
+LcsLengthResult lcsLengthMyersOnd_(const CharSequence &sequence1,
+                                   std::size_t startIndex1, std::size_t size1,
+                                   const CharSequence &sequence2,
+                                   std::size_t startIndex2, std::size_t size2) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  if (size1 == 0 || size2 == 0) {
+    return {0, internal::lcsDistance(size1, size2, 0)};
+  }
+
+  LcsLengthResult result;
+
+  result.lcsDistance = internal::lcsDistanceMyersOnd(
+      sequence1, startIndex1, size1, sequence2, startIndex2, size2);
+  result.lcsLength = (size1 + size2 - result.lcsDistance) / 2;
+  return result;
+}
+
+template <class CharSequence>
+LcsLengthResult lcsLengthMyersOnd(const CharSequence &sequence1,
+                                  const CharSequence &sequence2) {
+  return lcsLengthMyersOnd_(sequence1, 0, sequence1.size(), sequence2, 0,
+                            sequence2.size());
+}
+
+// Returns the length of the LCS of sequence1[startIndex1, startIndex1+size1)
+// and sequence2[startIndex2, startIndex2+size2). Does additional optimizations
+// on top of one of the other lcsLength functions.
+template <class CharSequence>
+LcsLengthResult lcsLength3_(
+    const CharSequence &sequence1, std::size_t startIndex1, std::size_t size1,
+    const CharSequence &sequence2, std::size_t startIndex2, std::size_t size2,
+    LcsLengthResult (*lcsLength)(const CharSequence &, std::size_t, std::size_t,
+                                 const CharSequence &, std::size_t,
+                                 std::size_t) = lcsLength2_<CharSequence>) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  if (size1 == 0 || size2 == 0) {
+    return {0, internal::lcsDistance(size1, size2, 0)};
+  }
+
+  const internal::CommonAffixes affixes = internal::commonAffixes(
+      sequence1, startIndex1, size1, sequence2, startIndex2, size2);
+  const std::size_t prefixLength = affixes.prefixLength;
+  const std::size_t suffixLength = affixes.suffixLength;
+  std::size_t smallerSize = std::min(size1, size2);
+
+  if (prefixLength == smallerSize) {
+    return {prefixLength, internal::lcsDistance(size1, size2, prefixLength)};
   }
 
   LcsLengthResult result = lcsLength(sequence1, startIndex1 + prefixLength,
@@ -228,6 +758,126 @@ LcsLengthResult lcsLength3(
 
 // Calculate max LCS distance for a pair of strings with given sizes.
 std::size_t maxLcsDistance(std::size_t size1, std::size_t size2);
+
+// Returns the LCS distance between sequence1[startIndex1, startIndex1+size1)
+// and sequence2[startIndex2, startIndex2+size2) if it is at most maxDistance.
+// Otherwise, returns maxDistance + 1. Only computes the diagonal band of width
+// 2 * maxDistance + 1 and stops as soon as every cell in a row exceeds
+// maxDistance. Takes O(max(size1, size2) * maxDistance) time. Uses only
+// O(min(size1, size2)) memory.
+template <class CharSequence>
+std::size_t lcsDistanceBounded_(const CharSequence &sequence1,
+                                std::size_t startIndex1, std::size_t size1,
+                                const CharSequence &sequence2,
+                                std::size_t startIndex2, std::size_t size2,
+                                std::size_t maxDistance) {
+  if (size1 < size2) {
+    return lcsDistanceBounded_(sequence2, startIndex2, size2, sequence1,
+                               startIndex1, size1, maxDistance);
+  }
+
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+  assert(size2 <= size1);
+
+  if (size1 - size2 > maxDistance) {
+    return maxDistance + 1;
+  }
+
+  if (maxDistance >= maxLcsDistance(size1, size2)) {
+    return lcsLength2_(sequence1, startIndex1, size1, sequence2, startIndex2,
+                       size2)
+        .lcsDistance;
+  }
+
+  // Any distance greater than maxDistance is stored as limit.
+  const std::size_t limit = maxDistance + 1;
+
+  // distances[n] will store the LCS distance between
+  // sequence1[startIndex1, startIndex1+row) and
+  // sequence2[startIndex2, startIndex2+n), or limit if that distance is greater
+  // than maxDistance or n is outside the band of row.
+  std::vector<std::size_t> distances(size2 + 1, limit);
+
+  for (std::size_t col = 0; col <= size2 && col < limit; ++col) {
+    distances[col] = col;
+  }
+
+  for (std::size_t i = 0; i < size1; ++i) {
+    std::size_t row = i + 1;
+    std::size_t firstCol = row > maxDistance ? row - maxDistance : 1;
+    std::size_t lastCol = std::min(size2, row + maxDistance);
+    std::size_t valueInPreviousColumnBeforeUpdate = distances[firstCol - 1];
+
+    distances[firstCol - 1] = firstCol == 1 ? std::min(row, limit) : limit;
+
+    // Without substitutions, column 0 can be the smallest in the row.
+    std::size_t minDistanceInRow = distances[firstCol - 1];
+
+    for (std::size_t col = firstCol; col <= lastCol; ++col) {
+      std::size_t j = col - 1;
+      std::size_t valueInColumnBeforeUpdate = distances[col];
+      std::size_t distance =
+          std::min({distances[col] + 1, distances[col - 1] + 1, limit});
+
+      if (sequence1[startIndex1 + i] == sequence2[startIndex2 + j]) {
+        distance = std::min(distance, valueInPreviousColumnBeforeUpdate);
+      }
+
+      distances[col] = distance;
+      minDistanceInRow = std::min(minDistanceInRow, distance);
+      valueInPreviousColumnBeforeUpdate = valueInColumnBeforeUpdate;
+    }
+
+    if (minDistanceInRow > maxDistance) {
+      return limit;
+    }
+  }
+
+  return distances[size2];
+}
+
+template <class CharSequence>
+std::size_t lcsDistanceBounded(const CharSequence &sequence1,
+                               const CharSequence &sequence2,
+                               std::size_t maxDistance) {
+  return lcsDistanceBounded_(sequence1, 0, sequence1.size(), sequence2, 0,
+                             sequence2.size(), maxDistance);
+}
+
+// Returns 1 - lcsDistance / maxLcsDistance, which is 1 for equal sequences and
+// 0 for sequences with nothing in common, if that is at least minSimilarity.
+// Otherwise, returns 0. minSimilarity is turned into the maxDistance of
+// lcsDistanceBounded_, so pairs far below it are rejected early.
+template <class CharSequence>
+double lcsSimilarity_(const CharSequence &sequence1, std::size_t startIndex1,
+                      std::size_t size1, const CharSequence &sequence2,
+                      std::size_t startIndex2, std::size_t size2,
+                      double minSimilarity = 0.0) {
+  const std::size_t maxDistance = maxLcsDistance(size1, size2);
+  const std::size_t allowedDistance =
+      internal::maxDistanceForSimilarity(maxDistance, minSimilarity);
+
+  if (allowedDistance > maxDistance) {
+    return 0.0;
+  }
+
+  const std::size_t distance =
+      lcsDistanceBounded_(sequence1, startIndex1, size1, sequence2,
+                          startIndex2, size2, allowedDistance);
+
+  return distance > allowedDistance
+             ? 0.0
+             : internal::similarity(distance, maxDistance);
+}
+
+template <class CharSequence>
+double lcsSimilarity(const CharSequence &sequence1,
+                     const CharSequence &sequence2,
+                     double minSimilarity = 0.0) {
+  return lcsSimilarity_(sequence1, 0, sequence1.size(), sequence2, 0,
+                        sequence2.size(), minSimilarity);
+}
 }  // namespace tlo
 
 #endif  // TLO_CPP_LCS_HPP
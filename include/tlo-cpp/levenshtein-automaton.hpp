@@ -0,0 +1,219 @@
+#ifndef TLO_CPP_LEVENSHTEIN_AUTOMATON_HPP
+#define TLO_CPP_LEVENSHTEIN_AUTOMATON_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace tlo {
+// DFA that accepts exactly the sequences within Levenshtein distance
+// maxDistance of a query. A state is a row of the Levenshtein table of the
+// query against the input read so far, with values clamped to maxDistance + 1.
+// All reachable states and their transitions are built up front, so reading a
+// symbol is a table lookup. Symbols are grouped into the distinct symbols of
+// the query plus one class for every other symbol. The number of states grows
+// quickly with maxDistance, so this is meant for small distances (at most 3).
+template <class Char>
+class LevenshteinAutomaton {
+ public:
+  using State = std::size_t;
+
+  // State from which no sequence is accepted.
+  static constexpr State DEAD = 0;
+
+ private:
+  std::size_t maxDistance_;
+
+  // Sorted distinct symbols of the query. Symbol class i is symbols_[i] and
+  // class symbols_.size() is every other symbol.
+  std::vector<Char> symbols_;
+
+  State start_ = DEAD;
+
+  // transitions_[state * (symbols_.size() + 1) + symbolClass] is the next
+  // state.
+  std::vector<State> transitions_;
+
+  // Distance between the query and the input read so far if at most
+  // maxDistance_, else maxDistance_ + 1.
+  std::vector<std::size_t> distances_;
+
+  std::size_t classOf(const Char &symbol) const {
+    auto iterator = std::lower_bound(symbols_.begin(), symbols_.end(), symbol);
+
+    if (iterator == symbols_.end() || symbol < *iterator) {
+      return symbols_.size();
+    }
+
+    return static_cast<std::size_t>(iterator - symbols_.begin());
+  }
+
+ public:
+  template <class CharSequence>
+  LevenshteinAutomaton(const CharSequence &query, std::size_t maxDistance)
+      : maxDistance_(maxDistance) {
+    const std::size_t size = query.size();
+    const std::size_t limit = maxDistance + 1;
+
+    for (std::size_t i = 0; i < size; ++i) {
+      symbols_.push_back(query[i]);
+    }
+
+    std::sort(symbols_.begin(), symbols_.end());
+    symbols_.erase(std::unique(symbols_.begin(), symbols_.end()),
+                   symbols_.end());
+
+    const std::size_t numClasses = symbols_.size() + 1;
+    std::map<std::vector<std::size_t>, State> states;
+    std::vector<std::vector<std::size_t>> rows;
+    const auto addState = [&](std::vector<std::size_t> row) {
+      auto [iterator, inserted] = states.try_emplace(row, rows.size());
+
+      if (inserted) {
+        distances_.push_back(row[size]);
+        rows.push_back(std::move(row));
+      }
+
+      return iterator->second;
+    };
+
+    addState(std::vector<std::size_t>(size + 1, limit));
+
+    std::vector<std::size_t> startRow(size + 1);
+
+    for (std::size_t col = 0; col <= size; ++col) {
+      startRow[col] = std::min(col, limit);
+    }
+
+    start_ = addState(std::move(startRow));
+
+    // rows grows while its states are expanded in order of discovery.
+    for (State state = 0; state < rows.size(); ++state) {
+      for (std::size_t symbolClass = 0; symbolClass < numClasses;
+           ++symbolClass) {
+        std::vector<std::size_t> row(size + 1);
+
+        row[0] = std::min(rows[state][0] + 1, limit);
+
+        for (std::size_t j = 0; j < size; ++j) {
+          std::size_t col = j + 1;
+          std::size_t substitutionCost = rows[state][col - 1];
+
+          if (symbolClass == symbols_.size() ||
+              symbols_[symbolClass] != query[j]) {
+            substitutionCost++;
+          }
+
+          row[col] = std::min({rows[state][col] + 1, row[col - 1] + 1,
+                               substitutionCost, limit});
+        }
+
+        State next = addState(std::move(row));
+
+        transitions_.push_back(next);
+      }
+    }
+  }
+
+  std::size_t maxDistance() const { return maxDistance_; }
+
+  std::size_t numStates() const { return distances_.size(); }
+
+  State start() const { return start_; }
+
+  // Returns the state after reading symbol in state.
+  State next(State state, const Char &symbol) const {
+    return transitions_[state * (symbols_.size() + 1) + classOf(symbol)];
+  }
+
+  bool isAccepting(State state) const {
+    return distances_[state] <= maxDistance_;
+  }
+
+  // Returns the Levenshtein distance between the query and the input read so
+  // far if state is accepting, else maxDistance() + 1.
+  std::size_t distance(State state) const { return distances_[state]; }
+};
+
+// Calls function(index, distance) for each sequence in sortedSequences that is
+// within the maximum distance of automaton, in order, where index is the
+// position of the sequence and distance its Levenshtein distance to the query.
+// sortedSequences must be sorted lexicographically by element. Consecutive
+// sequences reuse the automaton states of their common prefix, and once a
+// prefix reaches the dead state, all following sequences with that prefix are
+// skipped with a binary search.
+template <class Char, class CharSequence, class Function>
+void forEachLevenshteinMatch(const LevenshteinAutomaton<Char> &automaton,
+                             const std::vector<CharSequence> &sortedSequences,
+                             Function function) {
+  using State = typename LevenshteinAutomaton<Char>::State;
+
+  // states[n] is the state after reading the first n elements of previous.
+  std::vector<State> states = {automaton.start()};
+  const CharSequence *previous = nullptr;
+  std::size_t index = 0;
+
+  while (index < sortedSequences.size()) {
+    const CharSequence &sequence = sortedSequences[index];
+    std::size_t prefixLength = 0;
+
+    if (previous) {
+      while (prefixLength + 1 < states.size() &&
+             prefixLength < sequence.size() &&
+             (*previous)[prefixLength] == sequence[prefixLength]) {
+        prefixLength++;
+      }
+    }
+
+    states.resize(prefixLength + 1);
+    previous = &sequence;
+
+    bool dead = false;
+
+    while (states.size() <= sequence.size()) {
+      State state = automaton.next(states.back(), sequence[states.size() - 1]);
+
+      if (state == LevenshteinAutomaton<Char>::DEAD) {
+        dead = true;
+        break;
+      }
+
+      states.push_back(state);
+    }
+
+    if (!dead) {
+      if (automaton.isAccepting(states.back())) {
+        function(index, automaton.distance(states.back()));
+      }
+
+      index++;
+      continue;
+    }
+
+    // Skip every following sequence that starts with the dead prefix.
+    const std::size_t deadLength = states.size();
+    auto end = std::partition_point(
+        sortedSequences.begin() + static_cast<std::ptrdiff_t>(index) + 1,
+        sortedSequences.end(), [&](const CharSequence &other) {
+          if (other.size() < deadLength) {
+            return false;
+          }
+
+          for (std::size_t i = 0; i < deadLength; ++i) {
+            if (!(other[i] == sequence[i])) {
+              return false;
+            }
+          }
+
+          return true;
+        });
+
+    index = static_cast<std::size_t>(end - sortedSequences.begin());
+  }
+}
+}  // namespace tlo
+
+#endif  // TLO_CPP_LEVENSHTEIN_AUTOMATON_HPP
@@ -2,9 +2,23 @@
 #define TLO_CPP_LEVENSHTEIN_HPP
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include "tlo-cpp/anti-diagonal.hpp"
+#include "tlo-cpp/bit-parallel.hpp"
+#include "tlo-cpp/common-affixes.hpp"
+#include "tlo-cpp/dp-table.hpp"
+#include "tlo-cpp/edit-distance-workspace.hpp"
+#include "tlo-cpp/similarity.hpp"
+#include "tlo-cpp/wavefront.hpp"
+
 #ifdef TLO_CPP_DEBUG_LEVENSHTEIN
 #include <iostream>
 #endif
@@ -13,34 +27,30 @@ namespace tlo {
 // Calculate max Levenshtein distance for a pair of strings with given sizes.
 std::size_t maxLevenshteinDistance(std::size_t size1, std::size_t size2);
 
-// Returns the Levenshtein distance between
-// sequence1[startIndex1, startIndex1+size1) and
-// sequence2[startIndex2, startIndex2+size2). Takes O(size1 * size2) time.
-// Uses O(size1 * size2) memory.
-template <class CharSequence>
-std::size_t levenshteinDistance1_(const CharSequence &sequence1,
-                                  std::size_t startIndex1, std::size_t size1,
-                                  const CharSequence &sequence2,
-                                  std::size_t startIndex2, std::size_t size2) {
-  assert(startIndex1 + size1 <= sequence1.size());
-  assert(startIndex2 + size2 <= sequence2.size());
-
-  if (size1 == 0 || size2 == 0) {
-    return maxLevenshteinDistance(size1, size2);
-  }
-
-  // distances[m][n] will store the Levenshtein distance between
+// Calculate min Levenshtein distance for a pair of strings with given sizes.
+std::size_t minLevenshteinDistance(std::size_t size1, std::size_t size2);
+
+namespace internal {
+// Implements levenshteinDistance1_ using a table of Cell. Cell must be able to
+// hold maxLevenshteinDistance(size1, size2).
+template <class Cell, class CharSequence>
+std::size_t levenshteinDistance1WithCells(const CharSequence &sequence1,
+                                          std::size_t startIndex1,
+                                          std::size_t size1,
+                                          const CharSequence &sequence2,
+                                          std::size_t startIndex2,
+                                          std::size_t size2) {
+  // distances(m, n) will store the Levenshtein distance between
   // sequence1[startIndex1, startIndex1+m) and
   // sequence2[startIndex2, startIndex2+n).
-  std::vector<std::vector<std::size_t>> distances(
-      size1 + 1, std::vector<std::size_t>(size2 + 1, 0));
+  DpTable<Cell> distances(size1 + 1, size2 + 1);
 
   for (std::size_t row = 1; row <= size1; ++row) {
-    distances[row][0] = row;
+    distances(row, 0) = static_cast<Cell>(row);
   }
 
   for (std::size_t col = 1; col <= size2; ++col) {
-    distances[0][col] = col;
+    distances(0, col) = static_cast<Cell>(col);
   }
 
   for (std::size_t i = 0; i < size1; ++i) {
@@ -49,16 +59,16 @@ std::size_t levenshteinDistance1_(const CharSequence &sequence1,
     for (std::size_t j = 0; j < size2; ++j) {
       std::size_t col = j + 1;
 
-      std::size_t deletionCost = distances[row - 1][col] + 1;
-      std::size_t insertionCost = distances[row][col - 1] + 1;
-      std::size_t substitutionCost = distances[row - 1][col - 1];
+      std::size_t deletionCost = std::size_t{distances(row - 1, col)} + 1;
+      std::size_t insertionCost = std::size_t{distances(row, col - 1)} + 1;
+      std::size_t substitutionCost = distances(row - 1, col - 1);
 
       if (sequence1[startIndex1 + i] != sequence2[startIndex2 + j]) {
         substitutionCost++;
       }
 
-      distances[row][col] =
-          std::min({deletionCost, insertionCost, substitutionCost});
+      distances(row, col) = static_cast<Cell>(
+          std::min({deletionCost, insertionCost, substitutionCost}));
     }
   }
 
@@ -66,13 +76,39 @@ std::size_t levenshteinDistance1_(const CharSequence &sequence1,
   std::cerr << __func__ << " distances:" << std::endl;
   for (std::size_t i = 0; i <= size1; ++i) {
     for (std::size_t j = 0; j <= size2; ++j) {
-      std::cerr << distances[i][j] << " ";
+      std::cerr << std::size_t{distances(i, j)} << " ";
     }
     std::cerr << std::endl;
   }
 #endif
 
-  return distances[size1][size2];
+  return distances(size1, size2);
+}
+}  // namespace internal
+
+// Returns the Levenshtein distance between
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2). Takes O(size1 * size2) time.
+// Uses O(size1 * size2) memory in a single contiguous table whose cells are the
+// narrowest unsigned integers that can hold
+// maxLevenshteinDistance(size1, size2).
+template <class CharSequence>
+std::size_t levenshteinDistance1_(const CharSequence &sequence1,
+                                  std::size_t startIndex1, std::size_t size1,
+                                  const CharSequence &sequence2,
+                                  std::size_t startIndex2, std::size_t size2) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  if (size1 == 0 || size2 == 0) {
+    return maxLevenshteinDistance(size1, size2);
+  }
+
+  return internal::withNarrowestCell(
+      maxLevenshteinDistance(size1, size2), [&](auto cell) {
+        return internal::levenshteinDistance1WithCells<decltype(cell)>(
+            sequence1, startIndex1, size1, sequence2, startIndex2, size2);
+      });
 }
 
 template <class CharSequence>
@@ -82,51 +118,521 @@ std::size_t levenshteinDistance1(const CharSequence &sequence1,
                                sequence2.size());
 }
 
+// Cost policy of levenshteinDistanceWeighted that gives the Levenshtein
+// distance. A cost policy has a Cost type and const member functions
+// insertion(symbol) and deletion(symbol), which return the cost of inserting
+// and deleting symbol, and substitution(from, to), which returns the cost of
+// replacing from with to (usually 0 if they are equal). The functions are
+// called directly, so they can be inlined into the row loop.
+struct UnitLevenshteinCosts {
+  using Cost = std::size_t;
+
+  template <class Char>
+  Cost insertion(const Char &) const {
+    return 1;
+  }
+
+  template <class Char>
+  Cost deletion(const Char &) const {
+    return 1;
+  }
+
+  template <class Char>
+  Cost substitution(const Char &from, const Char &to) const {
+    return from == to ? 0 : 1;
+  }
+};
+
+namespace internal {
+// Sets distances to the first row of the table of levenshteinWeightedLastRow,
+// that is, distances[n] to the cost of inserting the first n elements of
+// sequence2[startIndex2, startIndex2+size2) (the last n ones if REVERSE is
+// true).
+template <bool REVERSE, class CostPolicy, class CharSequence>
+void levenshteinWeightedFirstRow(
+    const CharSequence &sequence2, std::size_t startIndex2, std::size_t size2,
+    const CostPolicy &costs,
+    std::vector<typename CostPolicy::Cost> &distances) {
+  using Cost = typename CostPolicy::Cost;
+
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  distances.resize(size2 + 1);
+  distances[0] = Cost{};
+
+  for (std::size_t j = 0; j < size2; ++j) {
+    const auto &charInSeq2 =
+        sequence2[REVERSE ? startIndex2 + size2 - 1 - j : startIndex2 + j];
+
+    distances[j + 1] = distances[j] + costs.insertion(charInSeq2);
+  }
+}
+
+// Advances distances from the row of the table of levenshteinWeightedLastRow
+// for some prefix of sequence1 to the row for that prefix followed by
+// charInSeq1. Takes O(size2) time.
+template <bool REVERSE, class CostPolicy, class CharSequence, class Char>
+void levenshteinWeightedNextRow(
+    const Char &charInSeq1, const CharSequence &sequence2,
+    std::size_t startIndex2, std::size_t size2, const CostPolicy &costs,
+    std::vector<typename CostPolicy::Cost> &distances) {
+  using Cost = typename CostPolicy::Cost;
+
+  assert(distances.size() == size2 + 1);
+
+  const Cost deletionOfCharInSeq1 = costs.deletion(charInSeq1);
+  Cost valueInPreviousColumnBeforeUpdate = distances[0];
+
+  distances[0] += deletionOfCharInSeq1;
+
+  for (std::size_t j = 0; j < size2; ++j) {
+    std::size_t col = j + 1;
+    Cost valueInColumnBeforeUpdate = distances[col];
+    const auto &charInSeq2 =
+        sequence2[REVERSE ? startIndex2 + size2 - 1 - j : startIndex2 + j];
+
+    // distances[row - 1][col - 1] -> valueInPreviousColumnBeforeUpdate.
+    // distances[row][col - 1] -> distances[col - 1].
+    // distances[row - 1][col] -> distances[col].
+    Cost deletionCost = distances[col] + deletionOfCharInSeq1;
+    Cost insertionCost = distances[col - 1] + costs.insertion(charInSeq2);
+    Cost substitutionCost = valueInPreviousColumnBeforeUpdate +
+                            costs.substitution(charInSeq1, charInSeq2);
+
+    distances[col] = std::min({deletionCost, insertionCost, substitutionCost});
+    valueInPreviousColumnBeforeUpdate = valueInColumnBeforeUpdate;
+  }
+}
+
+// Sets distances[n] to the minimum cost under costs of transforming
+// sequence1[startIndex1, startIndex1+size1) into
+// sequence2[startIndex2, startIndex2+n) for every n in [0, size2]. With
+// UnitLevenshteinCosts, that is the last row of the table of
+// levenshteinDistance1_. If REVERSE is true, both ranges are read back to
+// front, so distances[n] is instead the cost of transforming
+// sequence1[startIndex1, startIndex1+size1) into
+// sequence2[startIndex2+size2-n, startIndex2+size2). Takes O(size1 * size2)
+// time. Uses only the O(size2) memory of distances.
+template <bool REVERSE, class CostPolicy, class CharSequence>
+void levenshteinWeightedLastRow(
+    const CharSequence &sequence1, std::size_t startIndex1, std::size_t size1,
+    const CharSequence &sequence2, std::size_t startIndex2, std::size_t size2,
+    const CostPolicy &costs,
+    std::vector<typename CostPolicy::Cost> &distances) {
+  assert(startIndex1 + size1 <= sequence1.size());
+
+  levenshteinWeightedFirstRow<REVERSE>(sequence2, startIndex2, size2, costs,
+                                       distances);
+
+  for (std::size_t i = 0; i < size1; ++i) {
+    levenshteinWeightedNextRow<REVERSE>(
+        sequence1[REVERSE ? startIndex1 + size1 - 1 - i : startIndex1 + i],
+        sequence2, startIndex2, size2, costs, distances);
+  }
+}
+
+// Sets distances[n] to the Levenshtein distance between
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+n) for every n in [0, size2]. See
+// levenshteinWeightedLastRow for REVERSE.
+template <bool REVERSE, class CharSequence>
+void levenshteinLastRow(const CharSequence &sequence1, std::size_t startIndex1,
+                        std::size_t size1, const CharSequence &sequence2,
+                        std::size_t startIndex2, std::size_t size2,
+                        std::vector<std::size_t> &distances) {
+  levenshteinWeightedLastRow<REVERSE>(sequence1, startIndex1, size1, sequence2,
+                                      startIndex2, size2,
+                                      UnitLevenshteinCosts{}, distances);
+}
+}  // namespace internal
+
 // Returns the Levenshtein distance between
 // sequence1[startIndex1, startIndex1+size1) and
 // sequence2[startIndex2, startIndex2+size2). Takes O(size1 * size2) time.
-// Uses only O(min(size1, size2)) memory.
+// Uses only O(min(size1, size2)) memory, which comes from workspace.
+template <class CharSequence>
+std::size_t levenshteinDistance2WithWorkspace_(
+    const CharSequence &sequence1, std::size_t startIndex1, std::size_t size1,
+    const CharSequence &sequence2, std::size_t startIndex2, std::size_t size2,
+    EditDistanceWorkspace &workspace) {
+  if (size1 < size2) {
+    return levenshteinDistance2WithWorkspace_(sequence2, startIndex2, size2,
+                                              sequence1, startIndex1, size1,
+                                              workspace);
+  }
+
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+  assert(size2 <= size1);
+
+  if (size1 == 0 || size2 == 0) {
+    return maxLevenshteinDistance(size1, size2);
+  }
+
+  // distances[n] will store the Levenshtein distance between
+  // sequence1[startIndex1, startIndex1+size1) and
+  // sequence2[startIndex2, startIndex2+n).
+  std::vector<std::size_t> &distances = workspace.row();
+
+  internal::levenshteinLastRow<false>(sequence1, startIndex1, size1, sequence2,
+                                      startIndex2, size2, distances);
+
+#ifdef TLO_CPP_DEBUG_LEVENSHTEIN
+  std::cerr << __func__ << " distances:" << std::endl;
+  for (std::size_t j = 0; j <= size2; ++j) {
+    std::cerr << distances[j] << " ";
+  }
+  std::cerr << std::endl;
+#endif
+
+  return distances[size2];
+}
+
+// Like levenshteinDistance2WithWorkspace_ but uses the workspace of the calling
+// thread.
 template <class CharSequence>
 std::size_t levenshteinDistance2_(const CharSequence &sequence1,
                                   std::size_t startIndex1, std::size_t size1,
                                   const CharSequence &sequence2,
                                   std::size_t startIndex2, std::size_t size2) {
+  return levenshteinDistance2WithWorkspace_(
+      sequence1, startIndex1, size1, sequence2, startIndex2, size2,
+      EditDistanceWorkspace::threadLocal());
+}
+
+template <class CharSequence>
+std::size_t levenshteinDistance2(const CharSequence &sequence1,
+                                 const CharSequence &sequence2) {
+  return levenshteinDistance2_(sequence1, 0, sequence1.size(), sequence2, 0,
+                               sequence2.size());
+}
+
+// Returns the Levenshtein distance between
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2). Runs the row loop of
+// levenshteinDistance2_ over a std::array of CAPACITY + 1 cells instead of a
+// heap-allocated row, so it can be evaluated at compile time, e.g. on
+// std::string_view or std::array. Throws std::length_error if
+// min(size1, size2) > CAPACITY, which fails compilation in a constant
+// expression. Takes O(size1 * size2) time.
+template <std::size_t CAPACITY, class CharSequence>
+constexpr std::size_t levenshteinDistanceFixed_(const CharSequence &sequence1,
+                                                std::size_t startIndex1,
+                                                std::size_t size1,
+                                                const CharSequence &sequence2,
+                                                std::size_t startIndex2,
+                                                std::size_t size2) {
   if (size1 < size2) {
-    return levenshteinDistance2_(sequence2, startIndex2, size2, sequence1,
-                                 startIndex1, size1);
+    return levenshteinDistanceFixed_<CAPACITY>(sequence2, startIndex2, size2,
+                                               sequence1, startIndex1, size1);
   }
 
   assert(startIndex1 + size1 <= sequence1.size());
   assert(startIndex2 + size2 <= sequence2.size());
   assert(size2 <= size1);
 
+  if (size2 > CAPACITY) {
+    throw std::length_error(
+        "Error: Sequences are too long for levenshteinDistanceFixed_.");
+  }
+
+  std::array<std::size_t, CAPACITY + 1> distances{};
+
+  for (std::size_t j = 0; j <= size2; ++j) {
+    distances[j] = j;
+  }
+
+  for (std::size_t i = 0; i < size1; ++i) {
+    const auto &charInSeq1 = sequence1[startIndex1 + i];
+    std::size_t previousDiagonal = distances[0];
+
+    distances[0] = i + 1;
+
+    for (std::size_t j = 0; j < size2; ++j) {
+      std::size_t col = j + 1;
+      std::size_t previousAbove = distances[col];
+
+      distances[col] = std::min(
+          {previousAbove + 1, distances[col - 1] + 1,
+           previousDiagonal +
+               (charInSeq1 == sequence2[startIndex2 + j] ? 0 : 1)});
+      previousDiagonal = previousAbove;
+    }
+  }
+
+  return distances[size2];
+}
+
+template <std::size_t CAPACITY, class CharSequence>
+constexpr std::size_t levenshteinDistanceFixed(const CharSequence &sequence1,
+                                               const CharSequence &sequence2) {
+  return levenshteinDistanceFixed_<CAPACITY>(sequence1, 0, sequence1.size(),
+                                             sequence2, 0, sequence2.size());
+}
+
+// Returns the Levenshtein distance between
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2). Computes the same table as
+// levenshteinDistance2_, with tiles of tileSize cells on each anti-diagonal of
+// tiles computed concurrently by numThreads threads (0 means
+// defaultNumThreads()). See internal::wavefront. Only pays off when both
+// sequences are many tiles long. Takes O(size1 * size2) time. Uses
+// O(size1 + size2) memory.
+template <class CharSequence>
+std::size_t levenshteinDistanceWavefrontWithThreads_(
+    const CharSequence &sequence1, std::size_t startIndex1, std::size_t size1,
+    const CharSequence &sequence2, std::size_t startIndex2, std::size_t size2,
+    std::size_t numThreads,
+    std::size_t tileSize = internal::WAVEFRONT_TILE_SIZE) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  if (size1 == 0 || size2 == 0) {
+    return maxLevenshteinDistance(size1, size2);
+  }
+
+  std::vector<std::size_t> top(size2 + 1);
+  std::vector<std::size_t> left(size1 + 1);
+
+  for (std::size_t j = 0; j <= size2; ++j) {
+    top[j] = j;
+  }
+
+  for (std::size_t i = 0; i <= size1; ++i) {
+    left[i] = i;
+  }
+
+  internal::wavefront(
+      sequence1, startIndex1, size1, sequence2, startIndex2, size2, top, left,
+      numThreads, tileSize,
+      [](std::size_t upperLeft, std::size_t upper, std::size_t leftCell,
+         bool isMatch) {
+        return std::min(
+            {upper + 1, leftCell + 1, upperLeft + (isMatch ? 0 : 1)});
+      });
+
+  return top[size2];
+}
+
+// Like levenshteinDistanceWavefrontWithThreads_ but uses defaultNumThreads()
+// threads. Can be used as the levenshteinDistance of levenshteinDistance3_.
+template <class CharSequence>
+std::size_t levenshteinDistanceWavefront_(const CharSequence &sequence1,
+                                          std::size_t startIndex1,
+                                          std::size_t size1,
+                                          const CharSequence &sequence2,
+                                          std::size_t startIndex2,
+                                          std::size_t size2) {
+  return levenshteinDistanceWavefrontWithThreads_(
+      sequence1, startIndex1, size1, sequence2, startIndex2, size2, 0);
+}
+
+template <class CharSequence>
+std::size_t levenshteinDistanceWavefront(const CharSequence &sequence1,
+                                         const CharSequence &sequence2) {
+  return levenshteinDistanceWavefront_(sequence1, 0, sequence1.size(),
+                                       sequence2, 0, sequence2.size());
+}
+
+// Computes the Levenshtein distance between sequence2[startIndex2,
+// startIndex2+size2) and a sequence whose elements are pushed one row of the
+// table at a time, e.g. as chunks are read from a stream. Only one row is
+// kept, so memory is O(size2) however long the pushed sequence grows, and
+// each pushed element takes O(size2) time. sequence2 must outlive this.
+template <class CharSequence>
+class LevenshteinRowStream {
+ private:
+  const CharSequence *sequence2_;
+  std::size_t startIndex2_;
+  std::size_t size2_;
+  std::size_t size1_ = 0;
+  std::vector<std::size_t> distances_;
+
+ public:
+  LevenshteinRowStream(const CharSequence &sequence2, std::size_t startIndex2,
+                       std::size_t size2)
+      : sequence2_(&sequence2), startIndex2_(startIndex2), size2_(size2) {
+    internal::levenshteinWeightedFirstRow<false>(
+        sequence2, startIndex2, size2, UnitLevenshteinCosts{}, distances_);
+  }
+
+  explicit LevenshteinRowStream(const CharSequence &sequence2)
+      : LevenshteinRowStream(sequence2, 0, sequence2.size()) {}
+
+  template <class Char>
+  void push(const Char &charInSeq1) {
+    internal::levenshteinWeightedNextRow<false>(charInSeq1, *sequence2_,
+                                                startIndex2_, size2_,
+                                                UnitLevenshteinCosts{},
+                                                distances_);
+    ++size1_;
+  }
+
+  template <class Iterator>
+  void push(Iterator first, Iterator last) {
+    for (; first != last; ++first) {
+      push(*first);
+    }
+  }
+
+  // Returns the number of elements pushed so far.
+  std::size_t size1() const { return size1_; }
+
+  // Returns the Levenshtein distance between the elements pushed so far and
+  // sequence2[startIndex2, startIndex2+size2).
+  std::size_t distance() const { return distances_[size2_]; }
+};
+
+// Returns the minimum total cost under costs of the insertions, deletions, and
+// substitutions that transform sequence1[startIndex1, startIndex1+size1) into
+// sequence2[startIndex2, startIndex2+size2). See UnitLevenshteinCosts for what
+// CostPolicy must provide. Since costs need not be symmetric, the sequences
+// are never swapped. With UnitLevenshteinCosts, this is the Levenshtein
+// distance and runs the same row loop as levenshteinDistance2_. Takes
+// O(size1 * size2) time. Uses only O(size2) memory.
+template <class CostPolicy, class CharSequence>
+typename CostPolicy::Cost levenshteinDistanceWeighted_(
+    const CharSequence &sequence1, std::size_t startIndex1, std::size_t size1,
+    const CharSequence &sequence2, std::size_t startIndex2, std::size_t size2,
+    const CostPolicy &costs = CostPolicy{}) {
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+
+  std::vector<typename CostPolicy::Cost> distances;
+
+  internal::levenshteinWeightedLastRow<false>(sequence1, startIndex1, size1,
+                                              sequence2, startIndex2, size2,
+                                              costs, distances);
+  return distances[size2];
+}
+
+template <class CostPolicy, class CharSequence>
+typename CostPolicy::Cost levenshteinDistanceWeighted(
+    const CharSequence &sequence1, const CharSequence &sequence2,
+    const CostPolicy &costs = CostPolicy{}) {
+  return levenshteinDistanceWeighted_(sequence1, 0, sequence1.size(),
+                                      sequence2, 0, sequence2.size(), costs);
+}
+
+// Returns the Levenshtein distance between
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2). Evaluates the recurrence of
+// levenshteinDistance1_ along anti-diagonals with SSE4.1 or AVX2 (selected at
+// runtime) using the narrowest of 8-, 16-, or 32-bit lanes that can hold
+// maxLevenshteinDistance(size1, size2). Falls back to levenshteinDistance2_ if
+// the elements of CharSequence are not bytes, if the CPU supports neither
+// instruction set, or if the sequences are too long for 32-bit lanes. Takes
+// O(size1 * size2) time. Uses O(size1 + size2) memory.
+template <class CharSequence>
+std::size_t levenshteinDistanceSimd_(const CharSequence &sequence1,
+                                     std::size_t startIndex1, std::size_t size1,
+                                     const CharSequence &sequence2,
+                                     std::size_t startIndex2,
+                                     std::size_t size2) {
+  if (size1 > size2) {
+    return levenshteinDistanceSimd_(sequence2, startIndex2, size2, sequence1,
+                                    startIndex1, size1);
+  }
+
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+  assert(size1 <= size2);
+
   if (size1 == 0 || size2 == 0) {
     return maxLevenshteinDistance(size1, size2);
   }
 
+  if constexpr (sizeof(internal::CharOf<CharSequence>) == 1) {
+    const internal::SimdLevel level = internal::simdLevel();
+
+    if (level != internal::SimdLevel::NONE &&
+        maxLevenshteinDistance(size1, size2) <
+            std::numeric_limits<std::uint32_t>::max()) {
+      // Diagonals are indexed by positions in the shorter sequence1.
+      std::vector<unsigned char> bytes1 =
+          internal::toAntiDiagonalBytes(sequence1, startIndex1, size1, false);
+      std::vector<unsigned char> reversedBytes2 =
+          internal::toAntiDiagonalBytes(sequence2, startIndex2, size2, true);
+
+      return internal::levenshteinDistanceAntiDiagonal(
+          level, bytes1.data(), size1, reversedBytes2.data(), size2);
+    }
+  }
+
+  return levenshteinDistance2_(sequence1, startIndex1, size1, sequence2,
+                               startIndex2, size2);
+}
+
+template <class CharSequence>
+std::size_t levenshteinDistanceSimd(const CharSequence &sequence1,
+                                    const CharSequence &sequence2) {
+  return levenshteinDistanceSimd_(sequence1, 0, sequence1.size(), sequence2, 0,
+                                  sequence2.size());
+}
+
+// Returns the Levenshtein distance between
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2) if it is at most maxDistance.
+// Otherwise, returns maxDistance + 1. Only computes the diagonal band of width
+// 2 * maxDistance + 1 and stops as soon as every cell in a row exceeds
+// maxDistance. Takes O(max(size1, size2) * maxDistance) time. Uses only
+// O(min(size1, size2)) memory.
+template <class CharSequence>
+std::size_t levenshteinDistanceBounded_(const CharSequence &sequence1,
+                                        std::size_t startIndex1,
+                                        std::size_t size1,
+                                        const CharSequence &sequence2,
+                                        std::size_t startIndex2,
+                                        std::size_t size2,
+                                        std::size_t maxDistance) {
+  if (size1 < size2) {
+    return levenshteinDistanceBounded_(sequence2, startIndex2, size2,
+                                       sequence1, startIndex1, size1,
+                                       maxDistance);
+  }
+
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+  assert(size2 <= size1);
+
+  if (minLevenshteinDistance(size1, size2) > maxDistance) {
+    return maxDistance + 1;
+  }
+
+  if (maxDistance >= maxLevenshteinDistance(size1, size2)) {
+    return levenshteinDistance2_(sequence1, startIndex1, size1, sequence2,
+                                 startIndex2, size2);
+  }
+
+  if (size2 == 0) {
+    return size1;
+  }
+
+  // Any distance greater than maxDistance is stored as limit.
+  const std::size_t limit = maxDistance + 1;
+
   // distances[n] will store the Levenshtein distance between
-  // sequence1[startIndex1, startIndex1+size1) and
-  // sequence2[startIndex2, startIndex2+n).
-  std::vector<std::size_t> distances(size2 + 1, 0);
+  // sequence1[startIndex1, startIndex1+row) and
+  // sequence2[startIndex2, startIndex2+n), or limit if that distance is greater
+  // than maxDistance or n is outside the band of row.
+  std::vector<std::size_t> distances(size2 + 1, limit);
 
-  for (std::size_t col = 1; col <= size2; ++col) {
+  for (std::size_t col = 0; col <= size2 && col < limit; ++col) {
     distances[col] = col;
   }
 
   for (std::size_t i = 0; i < size1; ++i) {
     std::size_t row = i + 1;
-    std::size_t valueInPreviousColumnBeforeUpdate;
+    std::size_t firstCol = row > maxDistance ? row - maxDistance : 1;
+    std::size_t lastCol = std::min(size2, row + maxDistance);
+    std::size_t valueInPreviousColumnBeforeUpdate = distances[firstCol - 1];
+    std::size_t minDistanceInRow = limit;
 
-    distances[0] = row;
-    valueInPreviousColumnBeforeUpdate = row - 1;
+    distances[firstCol - 1] = firstCol == 1 ? std::min(row, limit) : limit;
 
-    for (std::size_t j = 0; j < size2; ++j) {
-      std::size_t col = j + 1;
+    for (std::size_t col = firstCol; col <= lastCol; ++col) {
+      std::size_t j = col - 1;
       std::size_t valueInColumnBeforeUpdate = distances[col];
-
-      // distances[row - 1][col - 1] -> valueInPreviousColumnBeforeUpdate.
-      // distances[row][col - 1] -> distances[col - 1].
-      // distances[row - 1][col] -> distances[col].
       std::size_t deletionCost = distances[col] + 1;
       std::size_t insertionCost = distances[col - 1] + 1;
       std::size_t substitutionCost = valueInPreviousColumnBeforeUpdate;
@@ -136,27 +642,305 @@ std::size_t levenshteinDistance2_(const CharSequence &sequence1,
       }
 
       distances[col] =
-          std::min({deletionCost, insertionCost, substitutionCost});
+          std::min({deletionCost, insertionCost, substitutionCost, limit});
+      minDistanceInRow = std::min(minDistanceInRow, distances[col]);
       valueInPreviousColumnBeforeUpdate = valueInColumnBeforeUpdate;
     }
-  }
 
-#ifdef TLO_CPP_DEBUG_LEVENSHTEIN
-  std::cerr << __func__ << " distances:" << std::endl;
-  for (std::size_t j = 0; j <= size2; ++j) {
-    std::cerr << distances[j] << " ";
+    if (minDistanceInRow > maxDistance) {
+      return limit;
+    }
   }
-  std::cerr << std::endl;
-#endif
 
   return distances[size2];
 }
 
 template <class CharSequence>
-std::size_t levenshteinDistance2(const CharSequence &sequence1,
-                                 const CharSequence &sequence2) {
-  return levenshteinDistance2_(sequence1, 0, sequence1.size(), sequence2, 0,
-                               sequence2.size());
+std::size_t levenshteinDistanceBounded(const CharSequence &sequence1,
+                                       const CharSequence &sequence2,
+                                       std::size_t maxDistance) {
+  return levenshteinDistanceBounded_(sequence1, 0, sequence1.size(),
+                                     sequence2, 0, sequence2.size(),
+                                     maxDistance);
+}
+
+// Returns 1 - levenshteinDistance / maxLevenshteinDistance, which is 1 for
+// equal sequences and 0 for sequences with nothing in common, if that is at
+// least minSimilarity. Otherwise, returns 0. minSimilarity is turned into the
+// maxDistance of levenshteinDistanceBounded_, so pairs far below it are
+// rejected early.
+template <class CharSequence>
+double levenshteinSimilarity_(const CharSequence &sequence1,
+                              std::size_t startIndex1, std::size_t size1,
+                              const CharSequence &sequence2,
+                              std::size_t startIndex2, std::size_t size2,
+                              double minSimilarity = 0.0) {
+  const std::size_t maxDistance = maxLevenshteinDistance(size1, size2);
+  const std::size_t allowedDistance =
+      internal::maxDistanceForSimilarity(maxDistance, minSimilarity);
+
+  if (allowedDistance > maxDistance) {
+    return 0.0;
+  }
+
+  const std::size_t distance =
+      levenshteinDistanceBounded_(sequence1, startIndex1, size1, sequence2,
+                                  startIndex2, size2, allowedDistance);
+
+  return distance > allowedDistance
+             ? 0.0
+             : internal::similarity(distance, maxDistance);
+}
+
+template <class CharSequence>
+double levenshteinSimilarity(const CharSequence &sequence1,
+                             const CharSequence &sequence2,
+                             double minSimilarity = 0.0) {
+  return levenshteinSimilarity_(sequence1, 0, sequence1.size(), sequence2, 0,
+                                sequence2.size(), minSimilarity);
+}
+
+namespace internal {
+// Advances one block of the vertical delta vectors of Myers' algorithm by one
+// column. positiveVertical and negativeVertical encode the vertical deltas of
+// the block (bit set if the delta is +1 or -1 respectively). carryIn is the
+// horizontal delta entering the bottom of the block. Returns the horizontal
+// delta at the bit selected by outBit. Based on "A Fast Bit-Vector Algorithm
+// for Approximate String Matching Based on Dynamic Programming" by Gene Myers
+// and its block-based formulation in "A Bit-Vector Algorithm for Computing
+// Levenshtein and Damerau Edit Distances" by Heikki Hyyro.
+inline int advanceLevenshteinBlock(Word &positiveVertical,
+                                   Word &negativeVertical, Word matches,
+                                   int carryIn, Word outBit) {
+  Word carryInIsNegative = carryIn < 0 ? Word{1} : Word{0};
+  Word verticalChange = matches | negativeVertical;
+
+  matches |= carryInIsNegative;
+
+  Word horizontalChange =
+      (((matches & positiveVertical) + positiveVertical) ^ positiveVertical) |
+      matches;
+  Word positiveHorizontal =
+      negativeVertical | ~(horizontalChange | positiveVertical);
+  Word negativeHorizontal = positiveVertical & horizontalChange;
+  int carryOut = 0;
+
+  if (positiveHorizontal & outBit) {
+    carryOut = 1;
+  } else if (negativeHorizontal & outBit) {
+    carryOut = -1;
+  }
+
+  positiveHorizontal <<= 1;
+  negativeHorizontal <<= 1;
+  negativeHorizontal |= carryInIsNegative;
+  positiveHorizontal |= carryIn > 0 ? Word{1} : Word{0};
+  positiveVertical =
+      negativeHorizontal | ~(verticalChange | positiveHorizontal);
+  negativeVertical = positiveHorizontal & verticalChange;
+  return carryOut;
+}
+
+// Returns the Levenshtein distance between the pattern described by
+// patternMatchVectors (of size patternSize > 0) and
+// text[startIndex, startIndex+size). positiveVertical and negativeVertical are
+// scratch buffers.
+template <class CharSequence, class Char>
+std::size_t levenshteinDistanceMyers(
+    const PatternMatchVectors<Char> &patternMatchVectors,
+    std::size_t patternSize, const CharSequence &text, std::size_t startIndex,
+    std::size_t size, std::vector<Word> &positiveVertical,
+    std::vector<Word> &negativeVertical) {
+  assert(patternSize > 0);
+  assert(startIndex + size <= text.size());
+
+  const std::size_t numBlocks = patternMatchVectors.numBlocks();
+  const std::size_t lastBlock = numBlocks - 1;
+  const Word lastBit = Word{1} << ((patternSize - 1) % WORD_SIZE);
+  std::size_t distance = patternSize;
+
+  if (numBlocks == 1) {
+    Word positive = ~Word{0};
+    Word negative = 0;
+
+    for (std::size_t i = 0; i < size; ++i) {
+      const Word *matches = patternMatchVectors.get(text[startIndex + i]);
+      int delta = advanceLevenshteinBlock(positive, negative, *matches, 1,
+                                          lastBit);
+
+      if (delta > 0) {
+        distance++;
+      } else if (delta < 0) {
+        distance--;
+      }
+    }
+
+    return distance;
+  }
+
+  positiveVertical.assign(numBlocks, ~Word{0});
+  negativeVertical.assign(numBlocks, 0);
+
+  for (std::size_t i = 0; i < size; ++i) {
+    const Word *matches = patternMatchVectors.get(text[startIndex + i]);
+    int carry = 1;
+
+    for (std::size_t block = 0; block < lastBlock; ++block) {
+      carry = advanceLevenshteinBlock(positiveVertical[block],
+                                      negativeVertical[block], matches[block],
+                                      carry, HIGH_BIT);
+    }
+
+    carry = advanceLevenshteinBlock(positiveVertical[lastBlock],
+                                    negativeVertical[lastBlock],
+                                    matches[lastBlock], carry, lastBit);
+
+    if (carry > 0) {
+      distance++;
+    } else if (carry < 0) {
+      distance--;
+    }
+  }
+
+  return distance;
+}
+}  // namespace internal
+
+// Returns the Levenshtein distance between
+// sequence1[startIndex1, startIndex1+size1) and
+// sequence2[startIndex2, startIndex2+size2). Uses Myers' bit-vector algorithm
+// with the shorter sequence as the pattern. Takes
+// O(ceil(min(size1, size2) / 64) * max(size1, size2)) time. Uses
+// O(ceil(min(size1, size2) / 64)) memory plus a table of bit vectors for the
+// alphabet of the shorter sequence.
+template <class CharSequence>
+std::size_t levenshteinDistanceMyers_(const CharSequence &sequence1,
+                                      std::size_t startIndex1,
+                                      std::size_t size1,
+                                      const CharSequence &sequence2,
+                                      std::size_t startIndex2,
+                                      std::size_t size2) {
+  if (size1 < size2) {
+    return levenshteinDistanceMyers_(sequence2, startIndex2, size2, sequence1,
+                                     startIndex1, size1);
+  }
+
+  assert(startIndex1 + size1 <= sequence1.size());
+  assert(startIndex2 + size2 <= sequence2.size());
+  assert(size2 <= size1);
+
+  if (size1 == 0 || size2 == 0) {
+    return maxLevenshteinDistance(size1, size2);
+  }
+
+  internal::PatternMatchVectors<internal::CharOf<CharSequence>>
+      patternMatchVectors;
+  std::vector<internal::Word> positiveVertical;
+  std::vector<internal::Word> negativeVertical;
+
+  patternMatchVectors.assign(sequence2, startIndex2, size2);
+  return internal::levenshteinDistanceMyers(patternMatchVectors, size2,
+                                            sequence1, startIndex1, size1,
+                                            positiveVertical, negativeVertical);
+}
+
+template <class CharSequence>
+std::size_t levenshteinDistanceMyers(const CharSequence &sequence1,
+                                     const CharSequence &sequence2) {
+  return levenshteinDistanceMyers_(sequence1, 0, sequence1.size(), sequence2,
+                                   0, sequence2.size());
+}
+
+// Writes the Levenshtein distance between query and each sequence in
+// candidates to consecutive positions starting at distances. Returns an
+// iterator past the last distance written. Uses Myers' bit-vector algorithm
+// with query as the pattern. The bit vectors of query are built only once and
+// the same scratch buffers are reused for every candidate.
+template <class CharSequence, class CharSequenceContainer,
+          class OutputIterator>
+OutputIterator levenshteinDistanceBatch(const CharSequence &query,
+                                        const CharSequenceContainer &candidates,
+                                        OutputIterator distances) {
+  internal::PatternMatchVectors<internal::CharOf<CharSequence>>
+      patternMatchVectors;
+  std::vector<internal::Word> positiveVertical;
+  std::vector<internal::Word> negativeVertical;
+
+  patternMatchVectors.assign(query, 0, query.size());
+
+  for (const auto &candidate : candidates) {
+    if (query.size() == 0 || candidate.size() == 0) {
+      *distances = maxLevenshteinDistance(query.size(), candidate.size());
+    } else {
+      *distances = internal::levenshteinDistanceMyers(
+          patternMatchVectors, query.size(), candidate, 0, candidate.size(),
+          positiveVertical, negativeVertical);
+    }
+
+    ++distances;
+  }
+
+  return distances;
+}
+
+// Returns the positions in candidates and the Levenshtein distances to query of
+// the k candidates closest to query, sorted by distance and then by position.
+// Ties at the cutoff go to the earlier candidate. Keeps the best k so far in a
+// max-heap. Once it is full, only a candidate closer than the worst of them can
+// enter, so candidates whose size differs from query by at least that much
+// are skipped and the rest are computed with levenshteinDistanceBounded_ using
+// one less than that distance as the bound.
+template <class CharSequence, class CharSequenceContainer>
+std::vector<std::pair<std::size_t, std::size_t>> nearestByLevenshtein(
+    const CharSequence &query, const CharSequenceContainer &candidates,
+    std::size_t k) {
+  if (k == 0) {
+    return {};
+  }
+
+  // Pairs of distance and position, so the top is the worst of the best k.
+  std::priority_queue<std::pair<std::size_t, std::size_t>> best;
+  std::size_t position = 0;
+
+  for (const auto &candidate : candidates) {
+    std::size_t distance;
+
+    if (best.size() < k) {
+      distance = levenshteinDistance2_(query, 0, query.size(), candidate, 0,
+                                       candidate.size());
+    } else {
+      std::size_t cutoff = best.top().first;
+
+      if (cutoff == 0 ||
+          minLevenshteinDistance(query.size(), candidate.size()) >= cutoff) {
+        position++;
+        continue;
+      }
+
+      distance =
+          levenshteinDistanceBounded_(query, 0, query.size(), candidate, 0,
+                                      candidate.size(), cutoff - 1);
+
+      if (distance >= cutoff) {
+        position++;
+        continue;
+      }
+
+      best.pop();
+    }
+
+    best.emplace(distance, position);
+    position++;
+  }
+
+  std::vector<std::pair<std::size_t, std::size_t>> nearest(best.size());
+
+  for (std::size_t i = nearest.size(); i > 0; --i) {
+    nearest[i - 1] = {best.top().second, best.top().first};
+    best.pop();
+  }
+
+  return nearest;
 }
 
 // Returns the Levenshtein distance between
@@ -177,16 +961,10 @@ std::size_t levenshteinDistance3_(
     return maxLevenshteinDistance(size1, size2);
   }
 
-  std::size_t prefixLength = 0;
-
-  for (std::size_t i = 0; i < size1 && i < size2; ++i) {
-    if (sequence1[startIndex1 + i] != sequence2[startIndex2 + i]) {
-      break;
-    }
-
-    prefixLength++;
-  }
-
+  const internal::CommonAffixes affixes = internal::commonAffixes(
+      sequence1, startIndex1, size1, sequence2, startIndex2, size2);
+  const std::size_t prefixLength = affixes.prefixLength;
+  const std::size_t suffixLength = affixes.suffixLength;
   std::size_t smallerSize = std::min(size1, size2);
   std::size_t largerSize = std::max(size1, size2);
 
@@ -194,22 +972,6 @@ std::size_t levenshteinDistance3_(
     return largerSize - smallerSize;
   }
 
-  std::size_t remainingLength = smallerSize - prefixLength;
-  std::size_t suffixLength = 0;
-
-  for (std::size_t i = size1 - 1, j = size2 - 1; i < size1 && j < size2;
-       --i, --j) {
-    if (sequence1[startIndex1 + i] != sequence2[startIndex2 + j]) {
-      break;
-    }
-
-    if (suffixLength == remainingLength) {
-      break;
-    }
-
-    suffixLength++;
-  }
-
   return levenshteinDistance(sequence1, startIndex1 + prefixLength,
                              size1 - prefixLength - suffixLength, sequence2,
                              startIndex2 + prefixLength,
@@ -0,0 +1,54 @@
+#ifndef TLO_CPP_MAPPED_FILE_HPP
+#define TLO_CPP_MAPPED_FILE_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <filesystem>
+
+namespace tlo {
+// A read-only view of a file mapped into memory. Models the CharSequence
+// accepted by the distance functions (size() and operator[]), so a file can be
+// compared without first being copied into a std::string. Pages are only read
+// in as they are touched.
+class MappedFile {
+ private:
+  const char *data_ = nullptr;
+  std::size_t size_ = 0;
+  bool isOpen_ = false;
+
+  void close() noexcept;
+
+ public:
+  // If default constructed, make sure open() is called before calling any of
+  // the other functions.
+  MappedFile() = default;
+
+  // Throws std::runtime_error on error.
+  explicit MappedFile(const std::filesystem::path &filePath);
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile(MappedFile &&mappedFile) noexcept;
+  ~MappedFile();
+
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile &operator=(MappedFile &&mappedFile) noexcept;
+
+  // Throws std::runtime_error on error. An empty file is open but has no
+  // mapping.
+  void open(const std::filesystem::path &filePath);
+  bool isOpen() const;
+
+  const char *data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+  const char &operator[](std::size_t index) const {
+    assert(index < size_);
+    return data_[index];
+  }
+
+  const char *begin() const { return data_; }
+  const char *end() const { return data_ + size_; }
+};
+}  // namespace tlo
+
+#endif  // TLO_CPP_MAPPED_FILE_HPP
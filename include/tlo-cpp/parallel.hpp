@@ -0,0 +1,22 @@
+#ifndef TLO_CPP_PARALLEL_HPP
+#define TLO_CPP_PARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+
+namespace tlo {
+// Returns std::thread::hardware_concurrency(), or 1 if it is unknown.
+std::size_t defaultNumThreads();
+
+// Calls task(i) for every i in [0, numTasks) using numThreads threads (the
+// calling thread is one of them). If numThreads is 0, uses
+// defaultNumThreads(). Each thread starts with a contiguous range of tasks,
+// takes tasks from the front of its own range, and steals tasks from the back
+// of the ranges of other threads when its own range is empty. If a task throws,
+// the remaining tasks are skipped and the first exception is rethrown after all
+// threads are joined.
+void parallelFor(std::size_t numTasks, std::size_t numThreads,
+                 const std::function<void(std::size_t)> &task);
+}  // namespace tlo
+
+#endif  // TLO_CPP_PARALLEL_HPP
@@ -0,0 +1,152 @@
+#ifndef TLO_CPP_Q_GRAM_HPP
+#define TLO_CPP_Q_GRAM_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "tlo-cpp/bit-parallel.hpp"
+#include "tlo-cpp/hash.hpp"
+#include "tlo-cpp/levenshtein.hpp"
+
+namespace tlo {
+namespace internal {
+// Returns a map from the hashes of the q-grams of sequence to their number of
+// occurrences. Distinct q-grams with the same hash are counted together.
+template <class CharSequence>
+std::unordered_map<std::size_t, std::size_t> countQGrams(
+    const CharSequence &sequence, std::size_t q) {
+  std::unordered_map<std::size_t, std::size_t> counts;
+
+  for (std::size_t start = 0; start + q <= sequence.size(); ++start) {
+    BoostStyleHashCombiner combiner;
+
+    for (std::size_t i = start; i < start + q; ++i) {
+      combiner.combineWith(std::hash<CharOf<CharSequence>>{}(sequence[i]));
+    }
+
+    counts[combiner.getHash()]++;
+  }
+
+  return counts;
+}
+}  // namespace internal
+
+// Inverted index from q-grams to the sequences that contain them. Finds
+// candidates for Levenshtein search with the q-gram lemma: if the distance
+// between x and y is at most k, they share at least
+// max(|x|, |y|) - q + 1 - k * q q-grams (counted with multiplicity). Only
+// stores sizes and q-gram postings, not the sequences. Q-grams are keyed by
+// hash, and a collision can only add candidates, never lose one.
+template <class CharSequence>
+class QGramIndex {
+ private:
+  struct Posting {
+    std::size_t id;
+    std::size_t count;
+  };
+
+  std::size_t q_;
+  std::vector<std::size_t> sizes_;
+
+  // Postings of each q-gram hash in increasing order of id.
+  std::unordered_map<std::size_t, std::vector<Posting>> postings_;
+
+ public:
+  explicit QGramIndex(std::size_t q) : q_(q) { assert(q > 0); }
+
+  std::size_t q() const { return q_; }
+
+  // Returns the number of indexed sequences.
+  std::size_t size() const { return sizes_.size(); }
+
+  // Indexes sequence. Returns its id, which is the number of sequences added
+  // before it.
+  std::size_t add(const CharSequence &sequence) {
+    const std::size_t id = sizes_.size();
+
+    sizes_.push_back(sequence.size());
+
+    for (const auto &[hash, count] : internal::countQGrams(sequence, q_)) {
+      postings_[hash].push_back({id, count});
+    }
+
+    return id;
+  }
+
+  // Returns, in increasing order, the ids of all sequences that may be within
+  // Levenshtein distance maxDistance of query. Every such sequence is
+  // returned, plus some that are not. A sequence is dropped if its size
+  // differs from that of query by more than maxDistance or if it shares too
+  // few q-grams with query. The q-gram test is skipped when the bound is not
+  // positive, e.g. for short sequences.
+  std::vector<std::size_t> candidates(const CharSequence &query,
+                                      std::size_t maxDistance) const {
+    std::vector<std::size_t> sharedCounts(sizes_.size(), 0);
+
+    for (const auto &[hash, queryCount] : internal::countQGrams(query, q_)) {
+      auto iterator = postings_.find(hash);
+
+      if (iterator == postings_.end()) {
+        continue;
+      }
+
+      for (const Posting &posting : iterator->second) {
+        sharedCounts[posting.id] += std::min(queryCount, posting.count);
+      }
+    }
+
+    std::vector<std::size_t> ids;
+    const std::size_t querySize = query.size();
+    const std::size_t slack = q_ - 1 + maxDistance * q_;
+
+    for (std::size_t id = 0; id < sizes_.size(); ++id) {
+      std::size_t size = sizes_[id];
+
+      if (std::max(size, querySize) - std::min(size, querySize) >
+          maxDistance) {
+        continue;
+      }
+
+      // Keep if sharedCounts[id] >= max(size, querySize) - slack.
+      if (sharedCounts[id] + slack >= std::max(size, querySize)) {
+        ids.push_back(id);
+      }
+    }
+
+    return ids;
+  }
+};
+
+// Returns the ids and distances, in increasing order of id, of the sequences
+// of corpus within Levenshtein distance maxDistance of query. index must have
+// been built from corpus in order. Only candidates of index are verified, with
+// levenshteinDistanceBounded_.
+template <class CharSequence>
+std::vector<std::pair<std::size_t, std::size_t>> levenshteinSearch(
+    const QGramIndex<CharSequence> &index,
+    const std::vector<CharSequence> &corpus, const CharSequence &query,
+    std::size_t maxDistance) {
+  assert(index.size() == corpus.size());
+
+  std::vector<std::pair<std::size_t, std::size_t>> matches;
+
+  for (std::size_t id : index.candidates(query, maxDistance)) {
+    std::size_t distance = levenshteinDistanceBounded_(
+        query, 0, query.size(), corpus[id], 0, corpus[id].size(),
+        maxDistance);
+
+    if (distance <= maxDistance) {
+      matches.emplace_back(id, distance);
+    }
+  }
+
+  return matches;
+}
+}  // namespace tlo
+
+#endif  // TLO_CPP_Q_GRAM_HPP
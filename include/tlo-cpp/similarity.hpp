@@ -0,0 +1,19 @@
+#ifndef TLO_CPP_SIMILARITY_HPP
+#define TLO_CPP_SIMILARITY_HPP
+
+#include <cstddef>
+
+namespace tlo {
+namespace internal {
+// Returns 1 - distance / maxDistance, or 1 if maxDistance is 0.
+double similarity(std::size_t distance, std::size_t maxDistance);
+
+// Returns the largest distance in [0, maxDistance] whose similarity() is at
+// least minSimilarity. If there is none, i.e. minSimilarity is greater than 1,
+// returns maxDistance + 1.
+std::size_t maxDistanceForSimilarity(std::size_t maxDistance,
+                                     double minSimilarity);
+}  // namespace internal
+}  // namespace tlo
+
+#endif  // TLO_CPP_SIMILARITY_HPP
@@ -0,0 +1,90 @@
+#ifndef TLO_CPP_TOKEN_DISTANCE_HPP
+#define TLO_CPP_TOKEN_DISTANCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "tlo-cpp/lcs.hpp"
+
+namespace tlo {
+enum class TokenGranularity {
+  // Tokens are the lines of a document. A trailing line break does not start
+  // another line, and a carriage return before a line break is dropped.
+  LINES,
+
+  // Tokens are the runs of non-whitespace characters of a document.
+  WORDS
+};
+
+// Maps each distinct token to a 64-bit ID, so two tokens get the same ID if and
+// only if they are equal. Token bytes are copied into large arena blocks that
+// are never moved, and the hash table indexes into them, so interning a
+// repeated token allocates nothing. Share one interner across a batch of
+// documents so that all of them use the same IDs.
+class TokenInterner {
+ private:
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char *block_ = nullptr;
+  std::size_t blockSize_;
+  std::size_t blockUsed_;
+
+  // tokens_[id] and hashes_[id] are the bytes and hash of the token with ID id.
+  std::vector<std::string_view> tokens_;
+  std::vector<std::uint64_t> hashes_;
+
+  // Open-addressed table whose slots hold ID + 1, or 0 if empty. Its size is a
+  // power of two and at least twice the number of tokens.
+  std::vector<std::size_t> slots_;
+
+  std::string_view store(std::string_view token);
+  void grow();
+
+ public:
+  explicit TokenInterner(std::size_t blockSize = std::size_t{1} << 16);
+
+  // Returns the ID of token, assigning the next unused ID if token is new.
+  std::uint64_t intern(std::string_view token);
+
+  // Returns the IDs of the tokens of document in order.
+  std::vector<std::uint64_t> tokenize(const std::string &document,
+                                      TokenGranularity granularity);
+
+  // Returns the number of distinct tokens interned.
+  std::size_t size() const;
+
+  // Returns the token with given ID. Stays valid as long as this interner.
+  std::string_view token(std::uint64_t id) const;
+};
+
+// Returns the Levenshtein distance between document1 and document2 counted in
+// tokens rather than characters. Takes O(n * m) time for n and m tokens, which
+// for line granularity is far less than the O(size1 * size2) of comparing the
+// characters.
+std::size_t tokenLevenshteinDistance(const std::string &document1,
+                                     const std::string &document2,
+                                     TokenGranularity granularity,
+                                     TokenInterner &interner);
+
+// Like above but uses a fresh interner.
+std::size_t tokenLevenshteinDistance(const std::string &document1,
+                                     const std::string &document2,
+                                     TokenGranularity granularity);
+
+// Returns the LCS length and LCS distance between document1 and document2
+// counted in tokens rather than characters.
+LcsLengthResult tokenLcsLength(const std::string &document1,
+                               const std::string &document2,
+                               TokenGranularity granularity,
+                               TokenInterner &interner);
+
+// Like above but uses a fresh interner.
+LcsLengthResult tokenLcsLength(const std::string &document1,
+                               const std::string &document2,
+                               TokenGranularity granularity);
+}  // namespace tlo
+
+#endif  // TLO_CPP_TOKEN_DISTANCE_HPP
@@ -0,0 +1,129 @@
+#ifndef TLO_CPP_UTF8_HPP
+#define TLO_CPP_UTF8_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "tlo-cpp/lcs.hpp"
+#include "tlo-cpp/token-distance.hpp"
+
+namespace tlo {
+enum class Utf8Unit {
+  // Units are Unicode code points.
+  CODE_POINTS,
+
+  // Units are grapheme clusters, i.e., what a reader sees as one character,
+  // like "e" followed by a combining acute accent, or a flag made of two
+  // regional indicators.
+  GRAPHEME_CLUSTERS
+};
+
+// Returns true if text only has bytes below 0x80. Checks 16 bytes at a time
+// with SSE2 where available and 8 bytes at a time otherwise.
+bool isAscii(std::string_view text);
+
+namespace internal {
+// Code points of a UTF-8 text, stored in the narrowest of std::uint8_t,
+// char16_t, and char32_t that holds all of them. Only the vector with units of
+// unitSize bytes is used; the others are empty.
+struct Utf8CodePoints {
+  std::size_t unitSize = 1;
+  std::vector<std::uint8_t> units8;
+  std::vector<char16_t> units16;
+  std::vector<char32_t> units32;
+};
+
+// Widens the units of codePoints to unitSize bytes (1, 2, or 4) if they are
+// narrower.
+void widenUtf8CodePoints(Utf8CodePoints &codePoints, std::size_t unitSize);
+
+// Appends the code points of text to codePoints in a single pass, widening
+// the units the first time a code point does not fit in them. A byte that
+// does not start a valid UTF-8 sequence is decoded as the lone surrogate
+// 0xDC00 + byte, which valid UTF-8 never produces, so distinct invalid bytes
+// stay distinct from each other and from every valid code point.
+void decodeUtf8(std::string_view text, Utf8CodePoints &codePoints);
+
+// Appends the IDs of the grapheme clusters of text to ids, interning the bytes
+// of each cluster with interner. Clusters follow the rules of Unicode's
+// extended grapheme clusters for CR LF, controls, combining marks, zero-width
+// joiners, regional indicator pairs, and Hangul syllables, with the marks
+// taken from a built-in table of the common scripts rather than the full
+// Unicode database.
+void graphemeClusterIds(std::string_view text, TokenInterner &interner,
+                        std::vector<std::uint32_t> &ids);
+}  // namespace internal
+
+// Calls function(sequence1, sequence2), where sequence1 and sequence2 hold the
+// units of the UTF-8 texts text1 and text2 and have the same type, and returns
+// what it returns. If both texts are ASCII (and, for grapheme clusters, have
+// no CR LF), the sequences are text1 and text2 themselves, so the byte
+// engines run without any copy. Otherwise, each text is decoded once into a
+// vector of the narrowest of std::uint8_t, char16_t, and char32_t that holds
+// all code points of both texts, so Latin-1 text takes one byte per unit and
+// most other text two. Only text with code points above U+FFFF, such as
+// emoji, takes four. The engines read elements by index in their inner loops,
+// so the units are decoded up front rather than read through a view over the
+// UTF-8 bytes, which would have to decode on every access or keep an index of
+// unit offsets no smaller than the decoded units. Grapheme clusters become
+// std::uint32_t IDs shared by both texts. function is typically a generic
+// lambda that calls one of the distance functions.
+template <class Function>
+auto withUtf8Units(std::string_view text1, std::string_view text2,
+                   Utf8Unit unit, Function function) {
+  if (isAscii(text1) && isAscii(text2) &&
+      (unit == Utf8Unit::CODE_POINTS ||
+       (text1.find("\r\n") == std::string_view::npos &&
+        text2.find("\r\n") == std::string_view::npos))) {
+    return function(text1, text2);
+  }
+
+  if (unit == Utf8Unit::GRAPHEME_CLUSTERS) {
+    TokenInterner interner(256);
+    std::vector<std::uint32_t> ids1;
+    std::vector<std::uint32_t> ids2;
+
+    internal::graphemeClusterIds(text1, interner, ids1);
+    internal::graphemeClusterIds(text2, interner, ids2);
+    return function(ids1, ids2);
+  }
+
+  internal::Utf8CodePoints codePoints1;
+  internal::Utf8CodePoints codePoints2;
+
+  internal::decodeUtf8(text1, codePoints1);
+  internal::widenUtf8CodePoints(codePoints2, codePoints1.unitSize);
+  internal::decodeUtf8(text2, codePoints2);
+  internal::widenUtf8CodePoints(codePoints1, codePoints2.unitSize);
+
+  if (codePoints1.unitSize == 1) {
+    return function(codePoints1.units8, codePoints2.units8);
+  }
+
+  if (codePoints1.unitSize == 2) {
+    return function(codePoints1.units16, codePoints2.units16);
+  }
+
+  return function(codePoints1.units32, codePoints2.units32);
+}
+
+// Returns levenshteinDistance3 over the units of the UTF-8 texts text1 and
+// text2.
+std::size_t utf8LevenshteinDistance(std::string_view text1,
+                                    std::string_view text2,
+                                    Utf8Unit unit = Utf8Unit::CODE_POINTS);
+
+// Returns damerLevenDistance2 over the units of the UTF-8 texts text1 and
+// text2.
+std::size_t utf8DamerLevenDistance(std::string_view text1,
+                                   std::string_view text2,
+                                   Utf8Unit unit = Utf8Unit::CODE_POINTS);
+
+// Returns lcsLength3 over the units of the UTF-8 texts text1 and text2.
+LcsLengthResult utf8LcsLength(std::string_view text1, std::string_view text2,
+                              Utf8Unit unit = Utf8Unit::CODE_POINTS);
+}  // namespace tlo
+
+#endif  // TLO_CPP_UTF8_HPP
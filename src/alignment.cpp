@@ -0,0 +1,55 @@
+#include "tlo-cpp/alignment.hpp"
+
+namespace tlo {
+std::ostream &operator<<(std::ostream &os, EditOperation operation) {
+  switch (operation) {
+    case EditOperation::MATCH:
+      return os << "MATCH";
+    case EditOperation::SUBSTITUTION:
+      return os << "SUBSTITUTION";
+    case EditOperation::INSERTION:
+      return os << "INSERTION";
+    case EditOperation::DELETION:
+      return os << "DELETION";
+  }
+
+  return os;
+}
+
+std::ostream &operator<<(std::ostream &os, const EditRun &run) {
+  return os << '{' << run.operation << ", " << run.length << '}';
+}
+
+bool operator==(const EditRun &run1, const EditRun &run2) {
+  return run1.operation == run2.operation && run1.length == run2.length;
+}
+
+std::ostream &operator<<(std::ostream &os, const std::vector<EditRun> &runs) {
+  os << '{';
+
+  for (std::size_t i = 0; i < runs.size(); ++i) {
+    if (i > 0) {
+      os << ", ";
+    }
+
+    os << runs[i];
+  }
+
+  return os << '}';
+}
+
+namespace internal {
+void appendEditRun(std::vector<EditRun> &runs, EditOperation operation,
+                   std::size_t length) {
+  if (length == 0) {
+    return;
+  }
+
+  if (!runs.empty() && runs.back().operation == operation) {
+    runs.back().length += length;
+  } else {
+    runs.push_back({operation, length});
+  }
+}
+}  // namespace internal
+}  // namespace tlo
@@ -0,0 +1,166 @@
+#include <immintrin.h>
+
+#include "anti-diagonal.hpp"
+
+// Compiled with AVX2 enabled. See src/anti-diagonal.hpp.
+
+namespace tlo {
+namespace internal {
+namespace {
+template <class LaneType>
+struct Avx2Ops {
+  using Lane = LaneType;
+  using Vector = __m256i;
+
+  static constexpr std::size_t LANES = sizeof(Vector) / sizeof(Lane);
+
+  static Vector load(const Lane *lanes) {
+    return _mm256_loadu_si256(reinterpret_cast<const Vector *>(lanes));
+  }
+
+  static void store(Lane *lanes, Vector vector) {
+    _mm256_storeu_si256(reinterpret_cast<Vector *>(lanes), vector);
+  }
+
+  // Loads LANES bytes and zero-extends each to a lane.
+  static Vector loadChars(const unsigned char *chars) {
+    if constexpr (sizeof(Lane) == 1) {
+      return _mm256_loadu_si256(reinterpret_cast<const Vector *>(chars));
+    } else if constexpr (sizeof(Lane) == 2) {
+      return _mm256_cvtepu8_epi16(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(chars)));
+    } else {
+      return _mm256_cvtepu8_epi32(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i *>(chars)));
+    }
+  }
+
+  static Vector set1(Lane value) {
+    if constexpr (sizeof(Lane) == 1) {
+      return _mm256_set1_epi8(static_cast<char>(value));
+    } else if constexpr (sizeof(Lane) == 2) {
+      return _mm256_set1_epi16(static_cast<short>(value));
+    } else {
+      return _mm256_set1_epi32(static_cast<int>(value));
+    }
+  }
+
+  static Vector add(Vector vector1, Vector vector2) {
+    if constexpr (sizeof(Lane) == 1) {
+      return _mm256_add_epi8(vector1, vector2);
+    } else if constexpr (sizeof(Lane) == 2) {
+      return _mm256_add_epi16(vector1, vector2);
+    } else {
+      return _mm256_add_epi32(vector1, vector2);
+    }
+  }
+
+  static Vector min(Vector vector1, Vector vector2) {
+    if constexpr (sizeof(Lane) == 1) {
+      return _mm256_min_epu8(vector1, vector2);
+    } else if constexpr (sizeof(Lane) == 2) {
+      return _mm256_min_epu16(vector1, vector2);
+    } else {
+      return _mm256_min_epu32(vector1, vector2);
+    }
+  }
+
+  static Vector max(Vector vector1, Vector vector2) {
+    if constexpr (sizeof(Lane) == 1) {
+      return _mm256_max_epu8(vector1, vector2);
+    } else if constexpr (sizeof(Lane) == 2) {
+      return _mm256_max_epu16(vector1, vector2);
+    } else {
+      return _mm256_max_epu32(vector1, vector2);
+    }
+  }
+
+  static Vector equal(Vector vector1, Vector vector2) {
+    if constexpr (sizeof(Lane) == 1) {
+      return _mm256_cmpeq_epi8(vector1, vector2);
+    } else if constexpr (sizeof(Lane) == 2) {
+      return _mm256_cmpeq_epi16(vector1, vector2);
+    } else {
+      return _mm256_cmpeq_epi32(vector1, vector2);
+    }
+  }
+
+  // Returns ~mask & vector.
+  static Vector andNot(Vector mask, Vector vector) {
+    return _mm256_andnot_si256(mask, vector);
+  }
+
+  // Returns lanes of vector2 where mask is set and lanes of vector1 elsewhere.
+  static Vector blend(Vector vector1, Vector vector2, Vector mask) {
+    return _mm256_blendv_epi8(vector1, vector2, mask);
+  }
+};
+
+template <class Lane>
+std::size_t levenshteinDistance(const unsigned char *sequence1,
+                                std::size_t size1,
+                                const unsigned char *reversedSequence2,
+                                std::size_t size2, Lane *diagonals) {
+  return antiDiagonal<Avx2Ops<Lane>, true>(sequence1, size1,
+                                           reversedSequence2, size2, diagonals);
+}
+
+template <class Lane>
+std::size_t lcsLength(const unsigned char *sequence1, std::size_t size1,
+                      const unsigned char *reversedSequence2,
+                      std::size_t size2, Lane *diagonals) {
+  return antiDiagonal<Avx2Ops<Lane>, false>(sequence1, size1,
+                                            reversedSequence2, size2,
+                                            diagonals);
+}
+}  // namespace
+
+std::size_t levenshteinDistanceAntiDiagonalAvx2(
+    const unsigned char *sequence1, std::size_t size1,
+    const unsigned char *reversedSequence2, std::size_t size2,
+    std::uint8_t *diagonals) {
+  return levenshteinDistance(sequence1, size1, reversedSequence2, size2,
+                             diagonals);
+}
+
+std::size_t levenshteinDistanceAntiDiagonalAvx2(
+    const unsigned char *sequence1, std::size_t size1,
+    const unsigned char *reversedSequence2, std::size_t size2,
+    std::uint16_t *diagonals) {
+  return levenshteinDistance(sequence1, size1, reversedSequence2, size2,
+                             diagonals);
+}
+
+std::size_t levenshteinDistanceAntiDiagonalAvx2(
+    const unsigned char *sequence1, std::size_t size1,
+    const unsigned char *reversedSequence2, std::size_t size2,
+    std::uint32_t *diagonals) {
+  return levenshteinDistance(sequence1, size1, reversedSequence2, size2,
+                             diagonals);
+}
+
+std::size_t lcsLengthAntiDiagonalAvx2(const unsigned char *sequence1,
+                                      std::size_t size1,
+                                      const unsigned char *reversedSequence2,
+                                      std::size_t size2,
+                                      std::uint8_t *diagonals) {
+  return lcsLength(sequence1, size1, reversedSequence2, size2, diagonals);
+}
+
+std::size_t lcsLengthAntiDiagonalAvx2(const unsigned char *sequence1,
+                                      std::size_t size1,
+                                      const unsigned char *reversedSequence2,
+                                      std::size_t size2,
+                                      std::uint16_t *diagonals) {
+  return lcsLength(sequence1, size1, reversedSequence2, size2, diagonals);
+}
+
+std::size_t lcsLengthAntiDiagonalAvx2(const unsigned char *sequence1,
+                                      std::size_t size1,
+                                      const unsigned char *reversedSequence2,
+                                      std::size_t size2,
+                                      std::uint32_t *diagonals) {
+  return lcsLength(sequence1, size1, reversedSequence2, size2, diagonals);
+}
+}  // namespace internal
+}  // namespace tlo
@@ -0,0 +1,182 @@
+#include "tlo-cpp/anti-diagonal.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+#include "anti-diagonal.hpp"
+#include "tlo-cpp/levenshtein.hpp"
+
+#if defined(TLO_CPP_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace tlo {
+namespace internal {
+namespace {
+SimdLevel detectSimdLevel() {
+#if defined(TLO_CPP_SIMD_X86) && defined(_MSC_VER)
+  int info[4];
+
+  __cpuid(info, 0);
+
+  const int maxLeaf = info[0];
+
+  __cpuid(info, 1);
+
+  const bool sse41 = (info[2] & (1 << 19)) != 0;
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+  bool avx2 = false;
+
+  // AVX2 also requires the OS to save the YMM registers.
+  if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6) {
+    __cpuidex(info, 7, 0);
+    avx2 = (info[1] & (1 << 5)) != 0;
+  }
+
+  if (avx2) {
+    return SimdLevel::AVX2;
+  }
+
+  if (sse41) {
+    return SimdLevel::SSE41;
+  }
+#elif defined(TLO_CPP_SIMD_X86)
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+
+  if (__builtin_cpu_supports("sse4.1")) {
+    return SimdLevel::SSE41;
+  }
+#endif
+
+  return SimdLevel::NONE;
+}
+
+// One lane per vector. Used for SimdLevel::NONE.
+template <class LaneType>
+struct ScalarOps {
+  using Lane = LaneType;
+  using Vector = LaneType;
+
+  static constexpr std::size_t LANES = 1;
+
+  static Vector load(const Lane *lanes) { return *lanes; }
+  static void store(Lane *lanes, Vector vector) { *lanes = vector; }
+  static Vector loadChars(const unsigned char *chars) { return *chars; }
+  static Vector set1(Lane value) { return value; }
+
+  static Vector add(Vector vector1, Vector vector2) {
+    return static_cast<Vector>(vector1 + vector2);
+  }
+
+  static Vector min(Vector vector1, Vector vector2) {
+    return std::min(vector1, vector2);
+  }
+
+  static Vector max(Vector vector1, Vector vector2) {
+    return std::max(vector1, vector2);
+  }
+
+  static Vector equal(Vector vector1, Vector vector2) {
+    return vector1 == vector2 ? std::numeric_limits<Vector>::max() : Vector{0};
+  }
+
+  static Vector andNot(Vector mask, Vector vector) {
+    return static_cast<Vector>(~mask & vector);
+  }
+
+  static Vector blend(Vector vector1, Vector vector2, Vector mask) {
+    return mask ? vector2 : vector1;
+  }
+};
+
+template <class Lane>
+std::size_t runAntiDiagonal(SimdLevel level, bool levenshtein,
+                            const unsigned char *sequence1, std::size_t size1,
+                            const unsigned char *reversedSequence2,
+                            std::size_t size2) {
+  std::vector<Lane> diagonals(3 * (size1 + 1 + ANTI_DIAGONAL_PADDING), 0);
+
+#ifdef TLO_CPP_SIMD_X86
+  if (level == SimdLevel::AVX2) {
+    return levenshtein ? levenshteinDistanceAntiDiagonalAvx2(
+                             sequence1, size1, reversedSequence2, size2,
+                             diagonals.data())
+                       : lcsLengthAntiDiagonalAvx2(sequence1, size1,
+                                                   reversedSequence2, size2,
+                                                   diagonals.data());
+  }
+
+  if (level == SimdLevel::SSE41) {
+    return levenshtein ? levenshteinDistanceAntiDiagonalSse41(
+                             sequence1, size1, reversedSequence2, size2,
+                             diagonals.data())
+                       : lcsLengthAntiDiagonalSse41(sequence1, size1,
+                                                    reversedSequence2, size2,
+                                                    diagonals.data());
+  }
+#else
+  static_cast<void>(level);
+#endif
+
+  return levenshtein ? antiDiagonal<ScalarOps<Lane>, true>(
+                           sequence1, size1, reversedSequence2, size2,
+                           diagonals.data())
+                     : antiDiagonal<ScalarOps<Lane>, false>(
+                           sequence1, size1, reversedSequence2, size2,
+                           diagonals.data());
+}
+
+// Calls runAntiDiagonal() with the narrowest lanes that can hold
+// maxValue + 1.
+std::size_t runAntiDiagonal(std::size_t maxValue, SimdLevel level,
+                            bool levenshtein, const unsigned char *sequence1,
+                            std::size_t size1,
+                            const unsigned char *reversedSequence2,
+                            std::size_t size2) {
+  assert(maxValue < std::numeric_limits<std::uint32_t>::max());
+
+  if (maxValue < std::numeric_limits<std::uint8_t>::max()) {
+    return runAntiDiagonal<std::uint8_t>(level, levenshtein, sequence1,
+                                         size1, reversedSequence2, size2);
+  }
+
+  if (maxValue < std::numeric_limits<std::uint16_t>::max()) {
+    return runAntiDiagonal<std::uint16_t>(level, levenshtein, sequence1,
+                                          size1, reversedSequence2, size2);
+  }
+
+  return runAntiDiagonal<std::uint32_t>(level, levenshtein, sequence1, size1,
+                                        reversedSequence2, size2);
+}
+}  // namespace
+
+SimdLevel simdLevel() {
+  static const SimdLevel level = detectSimdLevel();
+
+  return level;
+}
+
+std::size_t levenshteinDistanceAntiDiagonal(
+    SimdLevel level, const unsigned char *sequence1, std::size_t size1,
+    const unsigned char *reversedSequence2, std::size_t size2) {
+  return runAntiDiagonal(maxLevenshteinDistance(size1, size2), level, true,
+                         sequence1, size1, reversedSequence2, size2);
+}
+
+std::size_t lcsLengthAntiDiagonal(SimdLevel level,
+                                  const unsigned char *sequence1,
+                                  std::size_t size1,
+                                  const unsigned char *reversedSequence2,
+                                  std::size_t size2) {
+  return runAntiDiagonal(std::min(size1, size2), level, false, sequence1,
+                         size1, reversedSequence2, size2);
+}
+}  // namespace internal
+}  // namespace tlo
@@ -0,0 +1,143 @@
+#ifndef ANTI_DIAGONAL_HPP
+#define ANTI_DIAGONAL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tlo-cpp/anti-diagonal.hpp"
+
+// The kernels below are instantiated in translation units compiled with
+// instruction set flags (e.g., -mavx2). Such translation units must only
+// instantiate them with types local to the translation unit and must not use
+// inline functions from the standard library, otherwise the linker may pick
+// copies of those functions that use the wider instruction set.
+
+namespace tlo {
+namespace internal {
+// Diagonal k of the dynamic programming matrix is stored in an array indexed by
+// row i, where cell (i, j) has i + j == k. Cell (i, j) depends on cells (i-1,
+// j) and (i, j-1) of diagonal k-1 and cell (i-1, j-1) of diagonal k-2, so all
+// cells of diagonal k are independent and can be computed Ops::LANES at a time.
+// Sequence elements are compared with sequence1[i-1] and
+// reversedSequence2[size2-k+i], both of which are contiguous in i. diagonals
+// must hold 3 * (size1 + 1 + ANTI_DIAGONAL_PADDING) cells, one diagonal after
+// the other. Cells past the valid range of a diagonal may be overwritten with
+// garbage that is never read as a valid cell.
+template <class Ops, bool LEVENSHTEIN>
+std::size_t antiDiagonal(const unsigned char *sequence1, std::size_t size1,
+                         const unsigned char *reversedSequence2,
+                         std::size_t size2, typename Ops::Lane *diagonals) {
+  using Lane = typename Ops::Lane;
+  using Vector = typename Ops::Vector;
+
+  const std::size_t stride = size1 + 1 + ANTI_DIAGONAL_PADDING;
+  Lane *previous2 = diagonals;
+  Lane *previous1 = diagonals + stride;
+  Lane *current = diagonals + 2 * stride;
+  const Vector one = Ops::set1(1);
+
+  for (std::size_t k = 0; k <= size1 + size2; ++k) {
+    if (k > 0) {
+      std::size_t first = k > size2 ? k - size2 : 1;
+      std::size_t last = k - 1 < size1 ? k - 1 : size1;
+
+      for (std::size_t i = first; i <= last; i += Ops::LANES) {
+        Vector up = Ops::load(previous1 + i - 1);
+        Vector left = Ops::load(previous1 + i);
+        Vector diagonal = Ops::load(previous2 + i - 1);
+        Vector equal = Ops::equal(
+            Ops::loadChars(sequence1 + i - 1),
+            Ops::loadChars(reversedSequence2 + size2 - k + i));
+        Vector value;
+
+        if constexpr (LEVENSHTEIN) {
+          value = Ops::min(Ops::add(Ops::min(up, left), one),
+                           Ops::add(diagonal, Ops::andNot(equal, one)));
+        } else {
+          value = Ops::blend(Ops::max(up, left), Ops::add(diagonal, one),
+                             equal);
+        }
+
+        Ops::store(current + i, value);
+      }
+    }
+
+    Lane boundary = LEVENSHTEIN ? static_cast<Lane>(k) : Lane{0};
+
+    if (k <= size2) {
+      current[0] = boundary;
+    }
+
+    if (k <= size1) {
+      current[k] = boundary;
+    }
+
+    Lane *oldPrevious2 = previous2;
+
+    previous2 = previous1;
+    previous1 = current;
+    current = oldPrevious2;
+  }
+
+  return previous1[size1];
+}
+
+std::size_t levenshteinDistanceAntiDiagonalSse41(
+    const unsigned char *sequence1, std::size_t size1,
+    const unsigned char *reversedSequence2, std::size_t size2,
+    std::uint8_t *diagonals);
+std::size_t levenshteinDistanceAntiDiagonalSse41(
+    const unsigned char *sequence1, std::size_t size1,
+    const unsigned char *reversedSequence2, std::size_t size2,
+    std::uint16_t *diagonals);
+std::size_t levenshteinDistanceAntiDiagonalSse41(
+    const unsigned char *sequence1, std::size_t size1,
+    const unsigned char *reversedSequence2, std::size_t size2,
+    std::uint32_t *diagonals);
+std::size_t lcsLengthAntiDiagonalSse41(const unsigned char *sequence1,
+                                       std::size_t size1,
+                                       const unsigned char *reversedSequence2,
+                                       std::size_t size2,
+                                       std::uint8_t *diagonals);
+std::size_t lcsLengthAntiDiagonalSse41(const unsigned char *sequence1,
+                                       std::size_t size1,
+                                       const unsigned char *reversedSequence2,
+                                       std::size_t size2,
+                                       std::uint16_t *diagonals);
+std::size_t lcsLengthAntiDiagonalSse41(const unsigned char *sequence1,
+                                       std::size_t size1,
+                                       const unsigned char *reversedSequence2,
+                                       std::size_t size2,
+                                       std::uint32_t *diagonals);
+
+std::size_t levenshteinDistanceAntiDiagonalAvx2(
+    const unsigned char *sequence1, std::size_t size1,
+    const unsigned char *reversedSequence2, std::size_t size2,
+    std::uint8_t *diagonals);
+std::size_t levenshteinDistanceAntiDiagonalAvx2(
+    const unsigned char *sequence1, std::size_t size1,
+    const unsigned char *reversedSequence2, std::size_t size2,
+    std::uint16_t *diagonals);
+std::size_t levenshteinDistanceAntiDiagonalAvx2(
+    const unsigned char *sequence1, std::size_t size1,
+    const unsigned char *reversedSequence2, std::size_t size2,
+    std::uint32_t *diagonals);
+std::size_t lcsLengthAntiDiagonalAvx2(const unsigned char *sequence1,
+                                      std::size_t size1,
+                                      const unsigned char *reversedSequence2,
+                                      std::size_t size2,
+                                      std::uint8_t *diagonals);
+std::size_t lcsLengthAntiDiagonalAvx2(const unsigned char *sequence1,
+                                      std::size_t size1,
+                                      const unsigned char *reversedSequence2,
+                                      std::size_t size2,
+                                      std::uint16_t *diagonals);
+std::size_t lcsLengthAntiDiagonalAvx2(const unsigned char *sequence1,
+                                      std::size_t size1,
+                                      const unsigned char *reversedSequence2,
+                                      std::size_t size2,
+                                      std::uint32_t *diagonals);
+}  // namespace internal
+}  // namespace tlo
+
+#endif  // ANTI_DIAGONAL_HPP
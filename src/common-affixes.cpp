@@ -0,0 +1,80 @@
+#include "tlo-cpp/common-affixes.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(TLO_CPP_SIMD_X86) && (defined(__SSE2__) || defined(_M_X64))
+#define TLO_CPP_COMMON_AFFIXES_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace tlo {
+namespace internal {
+namespace {
+#ifdef TLO_CPP_COMMON_AFFIXES_SSE2
+bool equal16(const unsigned char *bytes1, const unsigned char *bytes2) {
+  const __m128i block1 =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes1));
+  const __m128i block2 =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes2));
+
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(block1, block2)) == 0xffff;
+}
+#endif
+
+bool equal8(const unsigned char *bytes1, const unsigned char *bytes2) {
+  std::uint64_t word1;
+  std::uint64_t word2;
+
+  std::memcpy(&word1, bytes1, sizeof(word1));
+  std::memcpy(&word2, bytes2, sizeof(word2));
+  return word1 == word2;
+}
+}  // namespace
+
+// Skips equal blocks of 16 and then 8 bytes, then finds the first difference
+// one byte at a time.
+std::size_t commonPrefixBytes(const unsigned char *bytes1,
+                              const unsigned char *bytes2, std::size_t size) {
+  std::size_t length = 0;
+
+#ifdef TLO_CPP_COMMON_AFFIXES_SSE2
+  while (length + 16 <= size && equal16(bytes1 + length, bytes2 + length)) {
+    length += 16;
+  }
+#endif
+
+  while (length + 8 <= size && equal8(bytes1 + length, bytes2 + length)) {
+    length += 8;
+  }
+
+  while (length < size && bytes1[length] == bytes2[length]) {
+    length++;
+  }
+
+  return length;
+}
+
+std::size_t commonSuffixBytes(const unsigned char *end1,
+                              const unsigned char *end2, std::size_t size) {
+  std::size_t length = 0;
+
+#ifdef TLO_CPP_COMMON_AFFIXES_SSE2
+  while (length + 16 <= size &&
+         equal16(end1 - length - 16, end2 - length - 16)) {
+    length += 16;
+  }
+#endif
+
+  while (length + 8 <= size && equal8(end1 - length - 8, end2 - length - 8)) {
+    length += 8;
+  }
+
+  while (length < size && *(end1 - length - 1) == *(end2 - length - 1)) {
+    length++;
+  }
+
+  return length;
+}
+}  // namespace internal
+}  // namespace tlo
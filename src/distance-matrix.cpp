@@ -0,0 +1,17 @@
+#include "tlo-cpp/distance-matrix.hpp"
+
+#include <cassert>
+
+namespace tlo {
+std::size_t condensedSize(std::size_t numSequences) {
+  return numSequences < 2 ? 0 : numSequences * (numSequences - 1) / 2;
+}
+
+std::size_t condensedIndex(std::size_t numSequences, std::size_t i,
+                           std::size_t j) {
+  assert(i < j);
+  assert(j < numSequences);
+
+  return i * numSequences - i * (i + 1) / 2 + (j - i - 1);
+}
+}  // namespace tlo
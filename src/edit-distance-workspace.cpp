@@ -0,0 +1,11 @@
+#include "tlo-cpp/edit-distance-workspace.hpp"
+
+namespace tlo {
+void EditDistanceWorkspace::release() { *this = EditDistanceWorkspace(); }
+
+EditDistanceWorkspace &EditDistanceWorkspace::threadLocal() {
+  thread_local EditDistanceWorkspace workspace;
+
+  return workspace;
+}
+}  // namespace tlo
@@ -4,4 +4,8 @@ namespace tlo {
 std::size_t maxLevenshteinDistance(std::size_t size1, std::size_t size2) {
   return std::max(size1, size2);
 }
+
+std::size_t minLevenshteinDistance(std::size_t size1, std::size_t size2) {
+  return std::max(size1, size2) - std::min(size1, size2);
+}
 }  // namespace tlo
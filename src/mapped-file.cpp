@@ -0,0 +1,148 @@
+#include "tlo-cpp/mapped-file.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "tlo-cpp/filesystem.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace tlo {
+namespace {
+[[noreturn]] void throwMapError(const fs::path &filePath) {
+  throw std::runtime_error("Error: Failed to map \"" + filePath.u8string() +
+                           "\" into memory.");
+}
+
+#ifdef _WIN32
+const char *mapFile(const fs::path &filePath, std::size_t) {
+  HANDLE file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr);
+
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("Error: Failed to open \"" + filePath.u8string() +
+                             "\".");
+  }
+
+  HANDLE mapping =
+      CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  CloseHandle(file);
+
+  if (mapping == nullptr) {
+    throwMapError(filePath);
+  }
+
+  // The view keeps the mapping alive after its handle is closed.
+  const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+  CloseHandle(mapping);
+
+  if (view == nullptr) {
+    throwMapError(filePath);
+  }
+
+  return static_cast<const char *>(view);
+}
+
+void unmapFile(const char *data, std::size_t) { UnmapViewOfFile(data); }
+#else
+const char *mapFile(const fs::path &filePath, std::size_t size) {
+  int fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+
+  if (fileDescriptor < 0) {
+    throw std::runtime_error("Error: Failed to open \"" + filePath.u8string() +
+                             "\".");
+  }
+
+  void *view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+  // The mapping keeps the file alive after its descriptor is closed.
+  ::close(fileDescriptor);
+
+  if (view == MAP_FAILED) {
+    throwMapError(filePath);
+  }
+
+  // The distance functions mostly read front to back, so ask for aggressive
+  // read-ahead. Failure only costs speed.
+  madvise(view, size, MADV_SEQUENTIAL);
+
+  return static_cast<const char *>(view);
+}
+
+void unmapFile(const char *data, std::size_t size) {
+  munmap(const_cast<char *>(data), size);
+}
+#endif
+}  // namespace
+
+MappedFile::MappedFile(const fs::path &filePath) { open(filePath); }
+
+MappedFile::MappedFile(MappedFile &&mappedFile) noexcept
+    : data_(std::exchange(mappedFile.data_, nullptr)),
+      size_(std::exchange(mappedFile.size_, 0)),
+      isOpen_(std::exchange(mappedFile.isOpen_, false)) {}
+
+MappedFile::~MappedFile() { close(); }
+
+MappedFile &MappedFile::operator=(MappedFile &&mappedFile) noexcept {
+  if (this != &mappedFile) {
+    close();
+    data_ = std::exchange(mappedFile.data_, nullptr);
+    size_ = std::exchange(mappedFile.size_, 0);
+    isOpen_ = std::exchange(mappedFile.isOpen_, false);
+  }
+
+  return *this;
+}
+
+void MappedFile::open(const fs::path &filePath) {
+  assert(!isOpen_);
+
+  std::uintmax_t fileSize = getFileSize(filePath);
+
+  if (fileSize > std::numeric_limits<std::size_t>::max()) {
+    throw std::runtime_error("Error: \"" + filePath.u8string() +
+                             "\" is too large to map into memory.");
+  }
+
+  // Mapping an empty file fails on some platforms, so leave it unmapped.
+  if (fileSize > 0) {
+    data_ = mapFile(filePath, static_cast<std::size_t>(fileSize));
+  }
+
+  size_ = static_cast<std::size_t>(fileSize);
+  isOpen_ = true;
+}
+
+bool MappedFile::isOpen() const { return isOpen_; }
+
+void MappedFile::close() noexcept {
+  if (data_ != nullptr) {
+    unmapFile(data_, size_);
+  }
+
+  data_ = nullptr;
+  size_ = 0;
+  isOpen_ = false;
+}
+}  // namespace tlo
@@ -0,0 +1,118 @@
+#include "tlo-cpp/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tlo {
+std::size_t defaultNumThreads() {
+  return std::max(std::size_t{std::thread::hardware_concurrency()},
+                  std::size_t{1});
+}
+
+namespace {
+// Range of tasks [begin, end) owned by one thread.
+struct TaskRange {
+  std::mutex mutex;
+  std::size_t begin = 0;
+  std::size_t end = 0;
+};
+
+bool popFront(TaskRange &range, std::size_t &task) {
+  std::lock_guard<std::mutex> lock(range.mutex);
+
+  if (range.begin == range.end) {
+    return false;
+  }
+
+  task = range.begin++;
+  return true;
+}
+
+bool popBack(TaskRange &range, std::size_t &task) {
+  std::lock_guard<std::mutex> lock(range.mutex);
+
+  if (range.begin == range.end) {
+    return false;
+  }
+
+  task = --range.end;
+  return true;
+}
+}  // namespace
+
+void parallelFor(std::size_t numTasks, std::size_t numThreads,
+                 const std::function<void(std::size_t)> &task) {
+  if (numThreads == 0) {
+    numThreads = defaultNumThreads();
+  }
+
+  numThreads = std::min(numThreads, numTasks);
+
+  if (numThreads <= 1) {
+    for (std::size_t i = 0; i < numTasks; ++i) {
+      task(i);
+    }
+
+    return;
+  }
+
+  std::vector<TaskRange> ranges(numThreads);
+
+  for (std::size_t i = 0; i < numThreads; ++i) {
+    ranges[i].begin = numTasks * i / numThreads;
+    ranges[i].end = numTasks * (i + 1) / numThreads;
+  }
+
+  std::atomic<bool> failed(false);
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+
+  auto work = [&](std::size_t thread) {
+    std::size_t taskIndex;
+
+    while (!failed) {
+      bool found = popFront(ranges[thread], taskIndex);
+
+      for (std::size_t i = 1; !found && i < numThreads; ++i) {
+        found = popBack(ranges[(thread + i) % numThreads], taskIndex);
+      }
+
+      if (!found) {
+        return;
+      }
+
+      try {
+        task(taskIndex);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+
+        if (!exception) {
+          exception = std::current_exception();
+        }
+
+        failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+
+  for (std::size_t i = 1; i < numThreads; ++i) {
+    threads.emplace_back(work, i);
+  }
+
+  work(0);
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+}  // namespace tlo
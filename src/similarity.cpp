@@ -0,0 +1,42 @@
+#include "tlo-cpp/similarity.hpp"
+
+#include <cmath>
+
+namespace tlo {
+namespace internal {
+double similarity(std::size_t distance, std::size_t maxDistance) {
+  if (maxDistance == 0) {
+    return 1.0;
+  }
+
+  return 1.0 - static_cast<double>(distance) / static_cast<double>(maxDistance);
+}
+
+std::size_t maxDistanceForSimilarity(std::size_t maxDistance,
+                                     double minSimilarity) {
+  if (minSimilarity <= 0.0) {
+    return maxDistance;
+  }
+
+  if (minSimilarity > 1.0) {
+    return maxDistance + 1;
+  }
+
+  // Start from the rounded estimate and fix it up with similarity() itself, so
+  // a distance is allowed exactly when its score would pass the threshold.
+  auto distance = static_cast<std::size_t>(
+      std::floor((1.0 - minSimilarity) * static_cast<double>(maxDistance)));
+
+  while (distance < maxDistance &&
+         similarity(distance + 1, maxDistance) >= minSimilarity) {
+    ++distance;
+  }
+
+  while (distance > 0 && similarity(distance, maxDistance) < minSimilarity) {
+    --distance;
+  }
+
+  return distance;
+}
+}  // namespace internal
+}  // namespace tlo
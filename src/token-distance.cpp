@@ -0,0 +1,190 @@
+#include "tlo-cpp/token-distance.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "tlo-cpp/levenshtein.hpp"
+#include "tlo-cpp/string.hpp"
+
+namespace tlo {
+namespace {
+// 64-bit FNV-1a.
+std::uint64_t hashToken(std::string_view token) {
+  std::uint64_t hash = 0xcbf29ce484222325U;
+
+  for (char c : token) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3U;
+  }
+
+  return hash;
+}
+
+bool isWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' ||
+         c == '\f';
+}
+}  // namespace
+
+TokenInterner::TokenInterner(std::size_t blockSize)
+    : blockSize_(std::max<std::size_t>(blockSize, 1)),
+      blockUsed_(blockSize_),
+      slots_(16, 0) {}
+
+std::string_view TokenInterner::store(std::string_view token) {
+  if (token.empty()) {
+    return {};
+  }
+
+  char *bytes;
+
+  // A token too large for a block gets one of its own, so the current block
+  // is not abandoned for it.
+  if (token.size() > blockSize_) {
+    blocks_.push_back(std::make_unique<char[]>(token.size()));
+    bytes = blocks_.back().get();
+  } else {
+    if (blockSize_ - blockUsed_ < token.size()) {
+      blocks_.push_back(std::make_unique<char[]>(blockSize_));
+      block_ = blocks_.back().get();
+      blockUsed_ = 0;
+    }
+
+    bytes = block_ + blockUsed_;
+    blockUsed_ += token.size();
+  }
+
+  std::memcpy(bytes, token.data(), token.size());
+  return {bytes, token.size()};
+}
+
+void TokenInterner::grow() {
+  std::vector<std::size_t> slots(slots_.size() * 2, 0);
+  const std::size_t mask = slots.size() - 1;
+
+  for (std::size_t id = 0; id < tokens_.size(); ++id) {
+    std::size_t slot = static_cast<std::size_t>(hashes_[id]) & mask;
+
+    while (slots[slot] != 0) {
+      slot = (slot + 1) & mask;
+    }
+
+    slots[slot] = id + 1;
+  }
+
+  slots_.swap(slots);
+}
+
+std::uint64_t TokenInterner::intern(std::string_view token) {
+  const std::uint64_t hash = hashToken(token);
+  const std::size_t mask = slots_.size() - 1;
+  std::size_t slot = static_cast<std::size_t>(hash) & mask;
+
+  while (slots_[slot] != 0) {
+    const std::size_t id = slots_[slot] - 1;
+
+    if (hashes_[id] == hash && tokens_[id] == token) {
+      return id;
+    }
+
+    slot = (slot + 1) & mask;
+  }
+
+  const std::size_t id = tokens_.size();
+
+  tokens_.push_back(store(token));
+  hashes_.push_back(hash);
+  slots_[slot] = id + 1;
+
+  if (2 * tokens_.size() > slots_.size()) {
+    grow();
+  }
+
+  return id;
+}
+
+std::vector<std::uint64_t> TokenInterner::tokenize(
+    const std::string &document, TokenGranularity granularity) {
+  std::vector<std::uint64_t> ids;
+
+  if (document.empty()) {
+    return ids;
+  }
+
+  if (granularity == TokenGranularity::LINES) {
+    auto lines = split(document, '\n');
+
+    if (document.back() == '\n') {
+      lines.pop_back();
+    }
+
+    ids.reserve(lines.size());
+
+    for (const auto &line : lines) {
+      std::string_view view = line;
+
+      if (!view.empty() && view.back() == '\r') {
+        view.remove_suffix(1);
+      }
+
+      ids.push_back(intern(view));
+    }
+  } else {
+    std::string spaced = document;
+
+    std::replace_if(spaced.begin(), spaced.end(), isWhitespace, ' ');
+
+    for (const auto &word : split(spaced, ' ')) {
+      if (!word.empty()) {
+        ids.push_back(intern(word));
+      }
+    }
+  }
+
+  return ids;
+}
+
+std::size_t TokenInterner::size() const { return tokens_.size(); }
+
+std::string_view TokenInterner::token(std::uint64_t id) const {
+  assert(id < tokens_.size());
+  return tokens_[static_cast<std::size_t>(id)];
+}
+
+std::size_t tokenLevenshteinDistance(const std::string &document1,
+                                     const std::string &document2,
+                                     TokenGranularity granularity,
+                                     TokenInterner &interner) {
+  const auto ids1 = interner.tokenize(document1, granularity);
+  const auto ids2 = interner.tokenize(document2, granularity);
+
+  return levenshteinDistance3(ids1, ids2);
+}
+
+std::size_t tokenLevenshteinDistance(const std::string &document1,
+                                     const std::string &document2,
+                                     TokenGranularity granularity) {
+  TokenInterner interner;
+
+  return tokenLevenshteinDistance(document1, document2, granularity, interner);
+}
+
+LcsLengthResult tokenLcsLength(const std::string &document1,
+                               const std::string &document2,
+                               TokenGranularity granularity,
+                               TokenInterner &interner) {
+  const auto ids1 = interner.tokenize(document1, granularity);
+  const auto ids2 = interner.tokenize(document2, granularity);
+
+  return lcsLength3(ids1, ids2);
+}
+
+LcsLengthResult tokenLcsLength(const std::string &document1,
+                               const std::string &document2,
+                               TokenGranularity granularity) {
+  TokenInterner interner;
+
+  return tokenLcsLength(document1, document2, granularity, interner);
+}
+}  // namespace tlo
@@ -0,0 +1,349 @@
+#include "tlo-cpp/utf8.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "tlo-cpp/damerau-levenshtein.hpp"
+#include "tlo-cpp/levenshtein.hpp"
+
+#if defined(TLO_CPP_SIMD_X86) && (defined(__SSE2__) || defined(_M_X64))
+#define TLO_CPP_UTF8_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace tlo {
+namespace {
+#ifdef TLO_CPP_UTF8_SSE2
+bool isAscii16(const char *bytes) {
+  const __m128i block =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes));
+
+  return _mm_movemask_epi8(block) == 0;
+}
+#endif
+
+bool isAscii8(const char *bytes) {
+  std::uint64_t word;
+
+  std::memcpy(&word, bytes, sizeof(word));
+  return (word & 0x8080808080808080U) == 0;
+}
+
+// Decodes the code point starting at text[index] and advances index past it.
+char32_t decodeCodePoint(std::string_view text, std::size_t &index) {
+  const auto byteAt = [&](std::size_t i) {
+    return static_cast<unsigned char>(text[i]);
+  };
+  const unsigned char leadByte = byteAt(index);
+
+  if (leadByte < 0x80) {
+    ++index;
+    return leadByte;
+  }
+
+  // Bounds of the second byte, which rule out overlong forms, surrogates, and
+  // code points above 0x10FFFF.
+  unsigned char lower = 0x80;
+  unsigned char upper = 0xBF;
+  std::size_t length = 0;
+  char32_t codePoint = 0;
+
+  if (leadByte >= 0xC2 && leadByte <= 0xDF) {
+    length = 2;
+    codePoint = leadByte & 0x1FU;
+  } else if (leadByte >= 0xE0 && leadByte <= 0xEF) {
+    length = 3;
+    codePoint = leadByte & 0x0FU;
+    lower = leadByte == 0xE0 ? 0xA0 : lower;
+    upper = leadByte == 0xED ? 0x9F : upper;
+  } else if (leadByte >= 0xF0 && leadByte <= 0xF4) {
+    length = 4;
+    codePoint = leadByte & 0x07U;
+    lower = leadByte == 0xF0 ? 0x90 : lower;
+    upper = leadByte == 0xF4 ? 0x8F : upper;
+  }
+
+  bool isValid = length > 0 && index + length <= text.size();
+
+  for (std::size_t k = 1; isValid && k < length; ++k) {
+    const unsigned char byte = byteAt(index + k);
+
+    isValid =
+        byte >= (k == 1 ? lower : 0x80) && byte <= (k == 1 ? upper : 0xBF);
+    codePoint = static_cast<char32_t>((codePoint << 6) | (byte & 0x3FU));
+  }
+
+  if (!isValid) {
+    ++index;
+    return static_cast<char32_t>(0xDC00U + leadByte);
+  }
+
+  index += length;
+  return codePoint;
+}
+
+// Returns the size in bytes of the narrowest unit that holds codePoint.
+std::size_t unitSizeOf(char32_t codePoint) {
+  return codePoint <= 0xFF ? 1 : codePoint <= 0xFFFF ? 2 : 4;
+}
+
+// Appends the code points of text from index on to units, and stops with
+// index at the first one that does not fit in Unit.
+template <class Unit>
+void decodeUtf8Into(std::string_view text, std::size_t &index,
+                    std::vector<Unit> &units) {
+  units.reserve(units.size() + text.size() - index);
+
+  while (index < text.size()) {
+    std::size_t nextIndex = index;
+    const char32_t codePoint = decodeCodePoint(text, nextIndex);
+
+    if (codePoint > static_cast<char32_t>(std::numeric_limits<Unit>::max())) {
+      return;
+    }
+
+    units.push_back(static_cast<Unit>(codePoint));
+    index = nextIndex;
+  }
+}
+
+template <class Unit, class WideUnit>
+void widenUnits(std::vector<Unit> &units, std::vector<WideUnit> &wideUnits) {
+  wideUnits.assign(units.begin(), units.end());
+  std::vector<Unit>().swap(units);
+}
+
+// Code points that never start a grapheme cluster: combining marks and the
+// spacing marks that attach to the preceding letter in Indic and Southeast
+// Asian scripts, variation selectors, emoji modifiers, and tags. Sorted.
+constexpr std::array<std::pair<char32_t, char32_t>, 61> EXTEND_RANGES = {{
+    {0x0300, 0x036F},   {0x0483, 0x0489},   {0x0591, 0x05BD},
+    {0x05BF, 0x05BF},   {0x05C1, 0x05C2},   {0x05C4, 0x05C5},
+    {0x05C7, 0x05C7},   {0x0610, 0x061A},   {0x064B, 0x065F},
+    {0x0670, 0x0670},   {0x06D6, 0x06DC},   {0x06DF, 0x06E4},
+    {0x06E7, 0x06E8},   {0x06EA, 0x06ED},   {0x0900, 0x0903},
+    {0x093A, 0x093C},   {0x093E, 0x094F},   {0x0951, 0x0957},
+    {0x0962, 0x0963},   {0x0981, 0x0983},   {0x09BC, 0x09BC},
+    {0x09BE, 0x09CD},   {0x09D7, 0x09D7},   {0x09E2, 0x09E3},
+    {0x0A01, 0x0A03},   {0x0A3C, 0x0A51},   {0x0A70, 0x0A71},
+    {0x0A75, 0x0A75},   {0x0A81, 0x0A83},   {0x0ABC, 0x0ABC},
+    {0x0ABE, 0x0ACD},   {0x0AE2, 0x0AE3},   {0x0B82, 0x0B82},
+    {0x0BBE, 0x0BCD},   {0x0BD7, 0x0BD7},   {0x0C00, 0x0C04},
+    {0x0C3E, 0x0C56},   {0x0C81, 0x0C83},   {0x0CBC, 0x0CBC},
+    {0x0CBE, 0x0CD6},   {0x0D00, 0x0D03},   {0x0D3B, 0x0D3C},
+    {0x0D3E, 0x0D4D},   {0x0D57, 0x0D57},   {0x0E31, 0x0E31},
+    {0x0E33, 0x0E3A},   {0x0E47, 0x0E4E},   {0x0EB1, 0x0EB1},
+    {0x0EB3, 0x0EBC},   {0x0EC8, 0x0ECE},   {0x1AB0, 0x1AFF},
+    {0x1DC0, 0x1DFF},   {0x200C, 0x200C},   {0x20D0, 0x20FF},
+    {0x302A, 0x302F},   {0x3099, 0x309A},   {0xFE00, 0xFE0F},
+    {0xFE20, 0xFE2F},   {0x1F3FB, 0x1F3FF}, {0xE0020, 0xE007F},
+    {0xE0100, 0xE01EF},
+}};
+
+constexpr char32_t ZERO_WIDTH_JOINER = 0x200D;
+
+bool isExtend(char32_t codePoint) {
+  const auto it = std::upper_bound(
+      EXTEND_RANGES.begin(), EXTEND_RANGES.end(), codePoint,
+      [](char32_t value, const std::pair<char32_t, char32_t> &range) {
+        return value < range.first;
+      });
+
+  return it != EXTEND_RANGES.begin() && codePoint <= (it - 1)->second;
+}
+
+bool isControl(char32_t codePoint) {
+  return codePoint < 0x20 || (codePoint >= 0x7F && codePoint <= 0x9F) ||
+         codePoint == 0x2028 || codePoint == 0x2029;
+}
+
+bool isRegionalIndicator(char32_t codePoint) {
+  return codePoint >= 0x1F1E6 && codePoint <= 0x1F1FF;
+}
+
+enum class HangulType { NONE, L, V, T, LV, LVT };
+
+HangulType hangulType(char32_t codePoint) {
+  if ((codePoint >= 0x1100 && codePoint <= 0x115F) ||
+      (codePoint >= 0xA960 && codePoint <= 0xA97C)) {
+    return HangulType::L;
+  }
+
+  if ((codePoint >= 0x1160 && codePoint <= 0x11A7) ||
+      (codePoint >= 0xD7B0 && codePoint <= 0xD7C6)) {
+    return HangulType::V;
+  }
+
+  if ((codePoint >= 0x11A8 && codePoint <= 0x11FF) ||
+      (codePoint >= 0xD7CB && codePoint <= 0xD7FB)) {
+    return HangulType::T;
+  }
+
+  if (codePoint >= 0xAC00 && codePoint <= 0xD7A3) {
+    // Every 28th precomposed syllable has no trailing consonant.
+    return (codePoint - 0xAC00) % 28 == 0 ? HangulType::LV : HangulType::LVT;
+  }
+
+  return HangulType::NONE;
+}
+
+// Returns true if Hangul jamo or syllables of the given types form one
+// syllable block.
+bool continuesHangulSyllable(HangulType previous, HangulType next) {
+  switch (previous) {
+    case HangulType::L:
+      return next == HangulType::L || next == HangulType::V ||
+             next == HangulType::LV || next == HangulType::LVT;
+    case HangulType::V:
+    case HangulType::LV:
+      return next == HangulType::V || next == HangulType::T;
+    case HangulType::T:
+    case HangulType::LVT:
+      return next == HangulType::T;
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+// Skips blocks of 16 and then 8 bytes that have no top bit set, then checks
+// one byte at a time.
+bool isAscii(std::string_view text) {
+  const char *bytes = text.data();
+  const std::size_t size = text.size();
+  std::size_t index = 0;
+
+#ifdef TLO_CPP_UTF8_SSE2
+  while (index + 16 <= size && isAscii16(bytes + index)) {
+    index += 16;
+  }
+#endif
+
+  while (index + 8 <= size && isAscii8(bytes + index)) {
+    index += 8;
+  }
+
+  while (index < size && static_cast<unsigned char>(bytes[index]) < 0x80) {
+    index++;
+  }
+
+  return index == size;
+}
+
+namespace internal {
+void widenUtf8CodePoints(Utf8CodePoints &codePoints, std::size_t unitSize) {
+  if (unitSize <= codePoints.unitSize) {
+    return;
+  }
+
+  if (codePoints.unitSize == 2) {
+    widenUnits(codePoints.units16, codePoints.units32);
+  } else if (unitSize == 2) {
+    widenUnits(codePoints.units8, codePoints.units16);
+  } else {
+    widenUnits(codePoints.units8, codePoints.units32);
+  }
+
+  codePoints.unitSize = unitSize;
+}
+
+void decodeUtf8(std::string_view text, Utf8CodePoints &codePoints) {
+  std::size_t index = 0;
+
+  while (true) {
+    if (codePoints.unitSize == 1) {
+      decodeUtf8Into(text, index, codePoints.units8);
+    } else if (codePoints.unitSize == 2) {
+      decodeUtf8Into(text, index, codePoints.units16);
+    } else {
+      decodeUtf8Into(text, index, codePoints.units32);
+    }
+
+    if (index == text.size()) {
+      return;
+    }
+
+    // Widens straight to the unit the code point that did not fit needs.
+    std::size_t nextIndex = index;
+
+    widenUtf8CodePoints(codePoints,
+                        unitSizeOf(decodeCodePoint(text, nextIndex)));
+  }
+}
+
+void graphemeClusterIds(std::string_view text, TokenInterner &interner,
+                        std::vector<std::uint32_t> &ids) {
+  std::size_t clusterStart = 0;
+  std::size_t index = 0;
+  char32_t previous = 0;
+
+  // Number of regional indicators in a row that end the current cluster.
+  std::size_t numRegionalIndicators = 0;
+
+  while (index < text.size()) {
+    const std::size_t start = index;
+    const char32_t codePoint = decodeCodePoint(text, index);
+    bool isBreak = true;
+
+    if (start == 0) {
+      isBreak = false;
+    } else if (previous == U'\r' && codePoint == U'\n') {
+      isBreak = false;
+    } else if (isControl(previous) || isControl(codePoint)) {
+      isBreak = true;
+    } else if (isExtend(codePoint) || codePoint == ZERO_WIDTH_JOINER ||
+               previous == ZERO_WIDTH_JOINER) {
+      isBreak = false;
+    } else if (isRegionalIndicator(previous) &&
+               isRegionalIndicator(codePoint)) {
+      isBreak = numRegionalIndicators % 2 == 0;
+    } else {
+      isBreak = !continuesHangulSyllable(hangulType(previous),
+                                         hangulType(codePoint));
+    }
+
+    if (isBreak) {
+      ids.push_back(static_cast<std::uint32_t>(
+          interner.intern(text.substr(clusterStart, start - clusterStart))));
+      clusterStart = start;
+    }
+
+    numRegionalIndicators =
+        isRegionalIndicator(codePoint) ? numRegionalIndicators + 1 : 0;
+    previous = codePoint;
+  }
+
+  if (clusterStart < text.size()) {
+    ids.push_back(static_cast<std::uint32_t>(
+        interner.intern(text.substr(clusterStart))));
+  }
+}
+}  // namespace internal
+
+std::size_t utf8LevenshteinDistance(std::string_view text1,
+                                    std::string_view text2, Utf8Unit unit) {
+  return withUtf8Units(text1, text2, unit,
+                       [](const auto &sequence1, const auto &sequence2) {
+                         return levenshteinDistance3(sequence1, sequence2);
+                       });
+}
+
+std::size_t utf8DamerLevenDistance(std::string_view text1,
+                                   std::string_view text2, Utf8Unit unit) {
+  return withUtf8Units(text1, text2, unit,
+                       [](const auto &sequence1, const auto &sequence2) {
+                         return damerLevenDistance2(sequence1, sequence2);
+                       });
+}
+
+LcsLengthResult utf8LcsLength(std::string_view text1, std::string_view text2,
+                              Utf8Unit unit) {
+  return withUtf8Units(text1, text2, unit,
+                       [](const auto &sequence1, const auto &sequence2) {
+                         return lcsLength3(sequence1, sequence2);
+                       });
+}
+}  // namespace tlo
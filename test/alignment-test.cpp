@@ -0,0 +1,145 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tlo-cpp/alignment.hpp>
+#include <tlo-cpp/lcs.hpp>
+#include <tlo-cpp/levenshtein.hpp>
+#include <tlo-cpp/test.hpp>
+#include <vector>
+
+#include "random-strings.hpp"
+
+namespace {
+using namespace std::string_literals;
+
+using Runs = std::vector<tlo::EditRun>;
+
+constexpr tlo::EditOperation MATCH = tlo::EditOperation::MATCH;
+constexpr tlo::EditOperation SUBSTITUTION = tlo::EditOperation::SUBSTITUTION;
+constexpr tlo::EditOperation INSERTION = tlo::EditOperation::INSERTION;
+constexpr tlo::EditOperation DELETION = tlo::EditOperation::DELETION;
+
+using tlo::test::makeString;
+
+// Applies runs to sequence1 using the elements of sequence2 for insertions
+// and substitutions. Returns an empty string if a MATCH run does not match.
+std::string apply(const std::string &sequence1, const std::string &sequence2,
+                  const Runs &runs) {
+  std::string result;
+  std::size_t index1 = 0;
+  std::size_t index2 = 0;
+
+  for (const tlo::EditRun &run : runs) {
+    for (std::size_t i = 0; i < run.length; ++i) {
+      if (run.operation == MATCH) {
+        if (sequence1[index1] != sequence2[index2]) {
+          return "";
+        }
+
+        result.push_back(sequence1[index1++]);
+        ++index2;
+      } else if (run.operation == SUBSTITUTION) {
+        result.push_back(sequence2[index2++]);
+        ++index1;
+      } else if (run.operation == INSERTION) {
+        result.push_back(sequence2[index2++]);
+      } else {
+        ++index1;
+      }
+    }
+  }
+
+  return index1 == sequence1.size() ? result : "";
+}
+
+// Returns the number of non-MATCH operations of runs.
+std::size_t cost(const Runs &runs) {
+  std::size_t total = 0;
+
+  for (const tlo::EditRun &run : runs) {
+    if (run.operation != MATCH) {
+      total += run.length;
+    }
+  }
+
+  return total;
+}
+
+TLO_TEST(levenshteinAlignment) {
+  TLO_EXPECT_EQ(tlo::levenshteinAlignment(""s, ""s), Runs());
+  TLO_EXPECT_EQ(tlo::levenshteinAlignment("GAC"s, ""s), (Runs{{DELETION, 3}}));
+  TLO_EXPECT_EQ(tlo::levenshteinAlignment(""s, "AGCAT"s),
+                (Runs{{INSERTION, 5}}));
+  TLO_EXPECT_EQ(tlo::levenshteinAlignment("0123456789"s, "0123456789"s),
+                (Runs{{MATCH, 10}}));
+  TLO_EXPECT_EQ(tlo::levenshteinAlignment("kitten"s, "sitting"s),
+                (Runs{{SUBSTITUTION, 1},
+                      {MATCH, 3},
+                      {SUBSTITUTION, 1},
+                      {MATCH, 1},
+                      {INSERTION, 1}}));
+
+  const std::vector<std::string> sequences = {
+      ""s,           "GAC"s,           "AGCAT"s,         "XMJYAUZ"s,
+      "MZJAWXU"s,    "___XMJYAUZ___"s, "__MZJAWXU___"s,  "01234567"s,
+      "abcdefghij"s, "aaabbb"s,        "aaabbb___bbbccc"s, "sitting"s,
+      "kitten"s,     "Sunday"s,        "Saturday"s,      "CA"s,
+      "ABC"s};
+
+  for (const std::string &sequence1 : sequences) {
+    for (const std::string &sequence2 : sequences) {
+      Runs runs = tlo::levenshteinAlignment(sequence1, sequence2);
+
+      TLO_EXPECT_EQ(apply(sequence1, sequence2, runs), sequence2);
+      TLO_EXPECT_EQ(cost(runs),
+                    tlo::levenshteinDistance2(sequence1, sequence2));
+    }
+  }
+}
+
+TLO_TEST(levenshteinAlignment_long_sequences) {
+  for (std::uint32_t seed = 0; seed < 20; ++seed) {
+    std::string sequence1 = makeString(150 + seed * 7, 4, seed);
+    std::string sequence2 = makeString(200 - seed * 5, 4, seed + 100);
+    Runs runs = tlo::levenshteinAlignment(sequence1, sequence2);
+
+    TLO_EXPECT_EQ(apply(sequence1, sequence2, runs), sequence2);
+    TLO_EXPECT_EQ(cost(runs), tlo::levenshteinDistance2(sequence1, sequence2));
+  }
+}
+
+TLO_TEST(lcsAlignment) {
+  TLO_EXPECT_EQ(tlo::lcsAlignment(""s, ""s), Runs());
+  TLO_EXPECT_EQ(tlo::lcsAlignment("GAC"s, ""s), (Runs{{DELETION, 3}}));
+  TLO_EXPECT_EQ(tlo::lcsAlignment(""s, "AGCAT"s), (Runs{{INSERTION, 5}}));
+  TLO_EXPECT_EQ(tlo::lcsAlignment("01234567"s, "abc"s),
+                (Runs{{DELETION, 8}, {INSERTION, 3}}));
+  TLO_EXPECT_EQ(tlo::lcsAlignment("aaabbbccc"s, "aaabbb___bbbccc"s),
+                (Runs{{MATCH, 6}, {INSERTION, 6}, {MATCH, 3}}));
+
+  for (std::uint32_t seed = 0; seed < 20; ++seed) {
+    std::string sequence1 = makeString(150 + seed * 7, 4, seed);
+    std::string sequence2 = makeString(200 - seed * 5, 4, seed + 100);
+    Runs runs = tlo::lcsAlignment(sequence1, sequence2);
+
+    TLO_EXPECT_EQ(apply(sequence1, sequence2, runs), sequence2);
+    TLO_EXPECT_EQ(cost(runs),
+                  tlo::lcsLength2(sequence1, sequence2).lcsDistance);
+
+    for (const tlo::EditRun &run : runs) {
+      TLO_EXPECT(run.operation != SUBSTITUTION);
+    }
+  }
+}
+
+TLO_TEST(longestCommonSubsequence) {
+  TLO_EXPECT_EQ(tlo::longestCommonSubsequence(""s, ""s), ""s);
+  TLO_EXPECT_EQ(tlo::longestCommonSubsequence("GAC"s, "AGCAT"s).size(), 2U);
+  TLO_EXPECT_EQ(tlo::longestCommonSubsequence("XMJYAUZ"s, "MZJAWXU"s),
+                "MJAU"s);
+  TLO_EXPECT_EQ(tlo::longestCommonSubsequence("sitting"s, "kitten"s),
+                "ittn"s);
+  TLO_EXPECT_EQ(tlo::longestCommonSubsequence("01234567"s, "abcdefghij"s),
+                ""s);
+}
+}  // namespace
@@ -0,0 +1,56 @@
+#include <string>
+#include <tlo-cpp/anti-diagonal.hpp>
+#include <tlo-cpp/lcs.hpp>
+#include <tlo-cpp/levenshtein.hpp>
+#include <tlo-cpp/test.hpp>
+#include <utility>
+#include <vector>
+
+#include "random-strings.hpp"
+
+namespace {
+using tlo::test::makeString;
+
+std::vector<tlo::internal::SimdLevel> supportedLevels() {
+  using tlo::internal::SimdLevel;
+
+  std::vector<SimdLevel> levels = {SimdLevel::NONE};
+
+  if (tlo::internal::simdLevel() != SimdLevel::NONE) {
+    levels.push_back(SimdLevel::SSE41);
+  }
+
+  if (tlo::internal::simdLevel() == SimdLevel::AVX2) {
+    levels.push_back(SimdLevel::AVX2);
+  }
+
+  return levels;
+}
+
+TLO_TEST(antiDiagonal) {
+  // Sizes are chosen to use 8-, 16-, and 32-bit lanes.
+  const std::vector<std::pair<std::size_t, std::size_t>> sizes = {
+      {1, 1},     {5, 9},     {16, 17},    {31, 33},  {100, 254},
+      {100, 300}, {3, 65534}, {40, 65535}, {2, 70000}};
+
+  for (auto level : supportedLevels()) {
+    for (const auto &[size1, size2] : sizes) {
+      const std::string string1 = makeString(size1, 3, 1);
+      const std::string string2 = makeString(size2, 3, 2);
+      const std::vector<unsigned char> bytes1 =
+          tlo::internal::toAntiDiagonalBytes(string1, 0, size1, false);
+      const std::vector<unsigned char> reversedBytes2 =
+          tlo::internal::toAntiDiagonalBytes(string2, 0, size2, true);
+
+      TLO_EXPECT_EQ(tlo::internal::levenshteinDistanceAntiDiagonal(
+                        level, bytes1.data(), size1, reversedBytes2.data(),
+                        size2),
+                    tlo::levenshteinDistance2(string1, string2));
+      TLO_EXPECT_EQ(tlo::internal::lcsLengthAntiDiagonal(
+                        level, bytes1.data(), size1, reversedBytes2.data(),
+                        size2),
+                    tlo::lcsLength2(string1, string2).lcsLength);
+    }
+  }
+}
+}  // namespace
@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <tlo-cpp/bk-tree.hpp>
+#include <tlo-cpp/damerau-levenshtein.hpp>
+#include <tlo-cpp/levenshtein.hpp>
+#include <tlo-cpp/test.hpp>
+#include <utility>
+#include <vector>
+
+#include "random-strings.hpp"
+
+namespace {
+using namespace std::string_literals;
+
+using tlo::test::makeString;
+
+std::size_t levenshtein(const std::string &string1,
+                        const std::string &string2) {
+  return tlo::levenshteinDistance3(string1, string2);
+}
+
+std::size_t damerLeven(const std::string &string1,
+                       const std::string &string2) {
+  return tlo::damerLevenDistance2(string1, string2);
+}
+
+using Metric = std::size_t (*)(const std::string &, const std::string &);
+using Matches = std::vector<std::pair<std::string, std::size_t>>;
+
+Matches sorted(Matches matches) {
+  std::sort(matches.begin(), matches.end());
+  return matches;
+}
+
+TLO_TEST(BkTree) {
+  tlo::BkTree<std::string, Metric> tree(levenshtein);
+
+  TLO_EXPECT(tree.empty());
+  TLO_EXPECT_EQ(tree.findWithin("book"s, 2).size(), 0U);
+
+  for (const std::string &word :
+       {"book"s, "books"s, "cake"s, "boo"s, "boon"s, "cook"s, "cape"s,
+        "cart"s}) {
+    TLO_EXPECT(tree.insert(word));
+  }
+
+  TLO_EXPECT(!tree.insert("cook"s));
+  TLO_EXPECT_EQ(tree.size(), 8U);
+  TLO_EXPECT(sorted(tree.findWithin("bo"s, 1)) == Matches({{"boo"s, 1}}));
+  TLO_EXPECT(sorted(tree.findWithin("book"s, 1)) ==
+             Matches({{"boo"s, 1},
+                      {"book"s, 0},
+                      {"books"s, 1},
+                      {"boon"s, 1},
+                      {"cook"s, 1}}));
+  TLO_EXPECT(sorted(tree.findWithin("caqe"s, 1)) ==
+             Matches({{"cake"s, 1}, {"cape"s, 1}}));
+  TLO_EXPECT_EQ(tree.findWithin("xyz"s, 0).size(), 0U);
+  TLO_EXPECT_EQ(tree.findWithin("xyz"s, 100).size(), 8U);
+}
+
+TLO_TEST(BkTree_matches_linear_scan) {
+  for (Metric metric : {Metric{levenshtein}, Metric{damerLeven}}) {
+    tlo::BkTree<std::string, Metric> tree(metric);
+    std::vector<std::string> words;
+
+    for (unsigned seed = 0; seed < 500; ++seed) {
+      std::string word = makeString(3 + seed % 6, 4, seed);
+
+      if (tree.insert(word)) {
+        words.push_back(word);
+      }
+    }
+
+    TLO_EXPECT_EQ(tree.size(), words.size());
+
+    for (unsigned seed = 1000; seed < 1020; ++seed) {
+      std::string query = makeString(2 + seed % 7, 4, seed);
+
+      for (std::size_t maxDistance = 0; maxDistance <= 3; ++maxDistance) {
+        Matches expected;
+
+        for (const std::string &word : words) {
+          std::size_t distance = metric(query, word);
+
+          if (distance <= maxDistance) {
+            expected.emplace_back(word, distance);
+          }
+        }
+
+        TLO_EXPECT(sorted(tree.findWithin(query, maxDistance)) ==
+                   sorted(expected));
+      }
+    }
+  }
+}
+}  // namespace
@@ -0,0 +1,86 @@
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <tlo-cpp/common-affixes.hpp>
+#include <tlo-cpp/test.hpp>
+#include <utility>
+#include <vector>
+
+namespace {
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+using Affixes = std::pair<std::size_t, std::size_t>;
+
+template <class CharSequence>
+Affixes affixes(const CharSequence &sequence1,
+                const CharSequence &sequence2) {
+  tlo::internal::CommonAffixes result = tlo::internal::commonAffixes(
+      sequence1, 0, sequence1.size(), sequence2, 0, sequence2.size());
+
+  return {result.prefixLength, result.suffixLength};
+}
+
+TLO_TEST(HasContiguousIntegers) {
+  TLO_EXPECT(tlo::internal::HasContiguousIntegers<std::string>::value);
+  TLO_EXPECT(tlo::internal::HasContiguousIntegers<std::string_view>::value);
+  TLO_EXPECT(tlo::internal::HasContiguousIntegers<std::u16string>::value);
+  TLO_EXPECT(tlo::internal::HasContiguousIntegers<std::vector<int>>::value);
+  TLO_EXPECT_FALSE(
+      tlo::internal::HasContiguousIntegers<std::vector<bool>>::value);
+  TLO_EXPECT_FALSE(
+      tlo::internal::HasContiguousIntegers<std::vector<double>>::value);
+  TLO_EXPECT_FALSE(
+      tlo::internal::HasContiguousIntegers<std::deque<char>>::value);
+}
+
+TLO_TEST(commonAffixes) {
+  TLO_EXPECT(affixes(""s, ""s) == Affixes(0, 0));
+  TLO_EXPECT(affixes("abc"s, ""s) == Affixes(0, 0));
+  TLO_EXPECT(affixes("abc"s, "abc"s) == Affixes(3, 0));
+  TLO_EXPECT(affixes("abc"s, "abcd"s) == Affixes(3, 0));
+  TLO_EXPECT(affixes("ab"s, "aab"s) == Affixes(1, 1));
+  TLO_EXPECT(affixes("kitten"s, "sitting"s) == Affixes(0, 0));
+  TLO_EXPECT(affixes("Sunday"s, "Saturday"s) == Affixes(1, 3));
+  TLO_EXPECT(affixes("Sunday"sv, "Saturday"sv) == Affixes(1, 3));
+  TLO_EXPECT(affixes(u"Sunday"s, u"Saturday"s) == Affixes(1, 3));
+  TLO_EXPECT(affixes(std::vector<int>{1, 2, 3, 4}, std::vector<int>{1, 5, 4}) ==
+             Affixes(1, 1));
+  TLO_EXPECT(affixes(std::vector<int>{1, 0x100}, std::vector<int>{1, 0x200}) ==
+             Affixes(1, 0));
+  TLO_EXPECT(affixes(std::deque<char>{'a', 'b', 'c'},
+                     std::deque<char>{'a', 'x', 'c'}) == Affixes(1, 1));
+}
+
+TLO_TEST(commonAffixes_long_sequences) {
+  for (std::size_t size : {7U, 8U, 15U, 16U, 17U, 40U, 100U}) {
+    const std::string base(size, 'a');
+
+    for (std::size_t position = 0; position < size; ++position) {
+      std::string changed = base;
+      std::deque<char> baseDeque(base.begin(), base.end());
+
+      changed[position] = 'b';
+
+      std::deque<char> changedDeque(changed.begin(), changed.end());
+      const auto expected = Affixes(position, size - position - 1);
+
+      TLO_EXPECT(affixes(base, changed) == expected);
+      TLO_EXPECT(affixes(baseDeque, changedDeque) == expected);
+      TLO_EXPECT(affixes(base + "xy"s, changed + "xy"s) ==
+                 Affixes(position, size - position + 1));
+    }
+  }
+
+  std::u16string string1(50, u'a');
+  std::u16string string2 = string1;
+
+  string2[20] = static_cast<char16_t>(u'a' + 0x100);
+  TLO_EXPECT(affixes(string1, string2) == Affixes(20, 29));
+
+  // A suffix never overlaps the prefix in the shorter sequence.
+  TLO_EXPECT(affixes(std::string(40, 'a'), std::string(30, 'a') + "b"s +
+                                               std::string(30, 'a')) ==
+             Affixes(30, 10));
+}
+}  // namespace
@@ -1,9 +1,18 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tlo-cpp/damerau-levenshtein.hpp>
 #include <tlo-cpp/test.hpp>
+#include <utility>
+#include <vector>
 
 namespace {
 using namespace std::string_literals;
+using namespace std::string_view_literals;
 
 TLO_TEST(damerLevenDistance1) {
   TLO_EXPECT_EQ(tlo::damerLevenDistance1(""s, ""s), 0U);
@@ -25,6 +34,109 @@ TLO_TEST(damerLevenDistance1) {
   TLO_EXPECT_EQ(tlo::damerLevenDistance1("CA"s, "ABC"s), 2U);
 }
 
+TLO_TEST(damerLevenDistance1_wide_cells) {
+  TLO_EXPECT_EQ(tlo::damerLevenDistance1(std::string(300, 'a') + "ba"s,
+                                         std::string(300, 'a') + "ab"s),
+                1U);
+  TLO_EXPECT_EQ(
+      tlo::damerLevenDistance1(std::string(300, 'a'), std::string(256, 'b')),
+      300U);
+}
+
+TLO_TEST(damerLevenDistance1_wide_elements) {
+  TLO_EXPECT_EQ(tlo::damerLevenDistance1(u"\u0141"s, u"\u0241"s), 1U);
+  TLO_EXPECT_EQ(
+      tlo::damerLevenDistance1(u"x\u0141\u0142y"s, u"x\u0142\u0141y"s), 1U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance1(U"\U0001F600ab"s, U"\U0002F600ba"s),
+                2U);
+
+  std::vector<std::uint32_t> tokens1 = {1000, 70000, 3, 1000, 5};
+  std::vector<std::uint32_t> tokens2 = {70000, 1000, 3, 5, 1000};
+
+  TLO_EXPECT_EQ(tlo::damerLevenDistance1(tokens1, tokens2), 2U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance1(tokens1, tokens2),
+                tlo::damerLevenDistance3(tokens1, tokens2));
+}
+
+TLO_TEST(damerLevenDistance3) {
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3(""s, ""s), 0U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("GAC"s, ""s), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3(""s, "AGCAT"s), 5U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("GAC"s, "AGCAT"s), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("XMJYAUZ"s, "MZJAWXU"s), 6U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("___XMJYAUZ___"s, "__MZJAWXU___"s),
+                7U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("__XMJYAUZ___"s, "___MZJAWXU___-"s),
+                7U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("0123456789"s, "0123456789"s), 0U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("01234567"s, "abcdefghij"s), 10U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("aaabbb"s, "aaabbb___bbbccc"s), 9U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("bbbccc"s, "aaabbb___bbbccc"s), 9U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("aaabbbccc"s, "aaabbb___bbbccc"s), 6U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("sitting"s, "kitten"s), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("Sunday"s, "Saturday"s), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("CA"s, "ABC"s), 2U);
+}
+
+TLO_TEST(damerLevenDistance3_long_sequences) {
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3(std::string(300, 'a') + "ba"s,
+                                         std::string(300, 'a') + "ab"s),
+                1U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance3("ab"s + std::string(300, 'c') + "d"s,
+                                         "b"s + std::string(300, 'c') + "ad"s),
+                2U);
+  TLO_EXPECT_EQ(
+      tlo::damerLevenDistance3(std::string(300, 'a'), std::string(256, 'b')),
+      300U);
+}
+
+TLO_TEST(damerLevenDistanceFixed) {
+  static_assert(tlo::damerLevenDistanceFixed<8>(""sv, ""sv) == 0);
+  static_assert(tlo::damerLevenDistanceFixed<8>("sitting"sv, "kitten"sv) ==
+                3);
+  static_assert(tlo::damerLevenDistanceFixed<4>("CA"sv, "ABC"sv) == 2);
+  static_assert(tlo::damerLevenDistanceFixed<3>(
+                    std::array<char, 3>{'G', 'A', 'C'},
+                    std::array<char, 3>{'A', 'G', 'C'}) == 1);
+
+  const char *strings[] = {"",
+                           "GAC",
+                           "AGCAT",
+                           "CA",
+                           "ABC",
+                           "XMJYAUZ",
+                           "MZJAWXU",
+                           "___XMJYAUZ___",
+                           "__MZJAWXU___-",
+                           "aaabbb___bbbccc",
+                           "abcdefg",
+                           "badcfeg"};
+
+  for (const char *string1 : strings) {
+    for (const char *string2 : strings) {
+      TLO_EXPECT_EQ(tlo::damerLevenDistanceFixed<16>(std::string_view(string1),
+                                                     std::string_view(string2)),
+                    tlo::damerLevenDistance3(std::string(string1),
+                                             std::string(string2)));
+    }
+  }
+
+  // Only the shorter sequence has to fit.
+  TLO_EXPECT_EQ(
+      tlo::damerLevenDistanceFixed<2>(std::string(300, 'a') + "ba"s, "ab"s),
+      300U);
+
+  bool threw = false;
+
+  try {
+    tlo::damerLevenDistanceFixed<4>("kitten"sv, "sitting"sv);
+  } catch (const std::length_error &) {
+    threw = true;
+  }
+
+  TLO_EXPECT(threw);
+}
+
 TLO_TEST(damerLevenDistance2_with_damerLevenDistance1) {
   TLO_EXPECT_EQ(tlo::damerLevenDistance2(""s, ""s), 0U);
   TLO_EXPECT_EQ(tlo::damerLevenDistance2("GAC"s, ""s), 3U);
@@ -44,4 +156,132 @@ TLO_TEST(damerLevenDistance2_with_damerLevenDistance1) {
   TLO_EXPECT_EQ(tlo::damerLevenDistance2("Sunday"s, "Saturday"s), 3U);
   TLO_EXPECT_EQ(tlo::damerLevenDistance2("CA"s, "ABC"s), 2U);
 }
+
+TLO_TEST(damerLevenDistance2_with_damerLevenDistance3) {
+  const auto &dld3_ = tlo::damerLevenDistance3_<std::string>;
+
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2(""s, ""s, dld3_), 0U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("GAC"s, ""s, dld3_), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2(""s, "AGCAT"s, dld3_), 5U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("GAC"s, "AGCAT"s, dld3_), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("XMJYAUZ"s, "MZJAWXU"s, dld3_), 6U);
+  TLO_EXPECT_EQ(
+      tlo::damerLevenDistance2("___XMJYAUZ___"s, "__MZJAWXU___"s, dld3_), 7U);
+  TLO_EXPECT_EQ(
+      tlo::damerLevenDistance2("__XMJYAUZ___"s, "___MZJAWXU___-"s, dld3_), 7U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("0123456789"s, "0123456789"s, dld3_),
+                0U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("01234567"s, "abcdefghij"s, dld3_),
+                10U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("aaabbb"s, "aaabbb___bbbccc"s, dld3_),
+                9U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("bbbccc"s, "aaabbb___bbbccc"s, dld3_),
+                9U);
+  TLO_EXPECT_EQ(
+      tlo::damerLevenDistance2("aaabbbccc"s, "aaabbb___bbbccc"s, dld3_), 6U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("sitting"s, "kitten"s, dld3_), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("Sunday"s, "Saturday"s, dld3_), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("CA"s, "ABC"s, dld3_), 2U);
+}
+
+
+TLO_TEST(damerLevenDistanceBounded) {
+  TLO_EXPECT_EQ(tlo::damerLevenDistanceBounded(""s, ""s, 0), 0U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistanceBounded("GAC"s, ""s, 3), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistanceBounded("GAC"s, ""s, 2), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistanceBounded("abcd"s, "bacd"s, 0), 1U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistanceBounded("abcd"s, "bacd"s, 1), 1U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistanceBounded("CA"s, "ABC"s, 2), 2U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistanceBounded("CA"s, "ABC"s, 1), 2U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistanceBounded("sitting"s, "kitten"s, 3), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistanceBounded("sitting"s, "kitten"s, 2), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistanceBounded("Sunday"s, "Saturday"s, 4),
+                3U);
+}
+
+TLO_TEST(damerLevenDistanceBounded_long_sequences) {
+  std::string sequence1;
+  std::string sequence2;
+
+  for (std::size_t i = 0; i < 200; ++i) {
+    sequence1.push_back(static_cast<char>('a' + i * 7 % 5));
+  }
+
+  sequence2 = sequence1;
+
+  for (std::size_t i = 10; i + 1 < sequence2.size(); i += 23) {
+    std::swap(sequence2[i], sequence2[i + 1]);
+  }
+
+  sequence2.erase(100, 3);
+
+  const std::size_t distance = tlo::damerLevenDistance3(sequence1, sequence2);
+
+  for (std::size_t maxDistance : {0U, 1U, 5U, 10U, 11U, 12U, 20U, 300U}) {
+    TLO_EXPECT_EQ(
+        tlo::damerLevenDistanceBounded(sequence1, sequence2, maxDistance),
+        std::min(distance, maxDistance + 1));
+  }
+}
+
+TLO_TEST(damerLevenSimilarity) {
+  TLO_EXPECT_EQ(tlo::damerLevenSimilarity(""s, ""s), 1.0);
+  TLO_EXPECT_EQ(tlo::damerLevenSimilarity("GAC"s, "GAC"s, 1.0), 1.0);
+  TLO_EXPECT_EQ(tlo::damerLevenSimilarity("GAC"s, "XYZ"s), 0.0);
+  TLO_EXPECT_EQ(tlo::damerLevenSimilarity("ab"s, "ba"s), 0.5);
+  TLO_EXPECT_EQ(tlo::damerLevenSimilarity("ab"s, "ba"s, 0.5), 0.5);
+  TLO_EXPECT_EQ(tlo::damerLevenSimilarity("ab"s, "ba"s, 0.6), 0.0);
+  TLO_EXPECT_EQ(tlo::damerLevenSimilarity("abcdefghij"s, "bacdefghji"s, 0.8),
+                0.8);
+  TLO_EXPECT_EQ(tlo::damerLevenSimilarity("GAC"s, "GAC"s, 1.5), 0.0);
+}
+
+TLO_TEST(damerLevenDistanceOsa) {
+  const auto &dldo = tlo::damerLevenDistanceOsa<std::string>;
+
+  TLO_EXPECT_EQ(dldo(""s, ""s), 0U);
+  TLO_EXPECT_EQ(dldo("GAC"s, ""s), 3U);
+  TLO_EXPECT_EQ(dldo(""s, "AGCAT"s), 5U);
+  TLO_EXPECT_EQ(dldo("GAC"s, "AGCAT"s), 3U);
+  TLO_EXPECT_EQ(dldo("XMJYAUZ"s, "MZJAWXU"s), 6U);
+  TLO_EXPECT_EQ(dldo("___XMJYAUZ___"s, "__MZJAWXU___"s), 7U);
+  TLO_EXPECT_EQ(dldo("__XMJYAUZ___"s, "___MZJAWXU___-"s), 7U);
+  TLO_EXPECT_EQ(dldo("0123456789"s, "0123456789"s), 0U);
+  TLO_EXPECT_EQ(dldo("01234567"s, "abcdefghij"s), 10U);
+  TLO_EXPECT_EQ(dldo("aaabbb"s, "aaabbb___bbbccc"s), 9U);
+  TLO_EXPECT_EQ(dldo("bbbccc"s, "aaabbb___bbbccc"s), 9U);
+  TLO_EXPECT_EQ(dldo("aaabbbccc"s, "aaabbb___bbbccc"s), 6U);
+  TLO_EXPECT_EQ(dldo("sitting"s, "kitten"s), 3U);
+  TLO_EXPECT_EQ(dldo("Sunday"s, "Saturday"s), 3U);
+  TLO_EXPECT_EQ(dldo("CA"s, "ABC"s), 3U);
+  TLO_EXPECT_EQ(dldo("abcd"s, "badc"s), 2U);
+}
+
+TLO_TEST(damerLevenDistanceOsa_long_sequences) {
+  std::string sequence1(200, 'a');
+  std::string sequence2(200, 'a');
+
+  sequence1[63] = 'b';
+  sequence2[64] = 'b';
+  sequence1[150] = 'c';
+  sequence2[151] = 'c';
+
+  TLO_EXPECT_EQ(tlo::damerLevenDistanceOsa(sequence1, sequence2), 2U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistanceOsa(std::string(130, 'a'),
+                                           std::string(70, 'b')),
+                130U);
+}
+
+TLO_TEST(damerLevenDistance2_with_damerLevenDistanceOsa) {
+  const auto &dldo_ = tlo::damerLevenDistanceOsa_<std::string>;
+
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2(""s, ""s, dldo_), 0U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("GAC"s, "AGCAT"s, dldo_), 3U);
+  TLO_EXPECT_EQ(
+      tlo::damerLevenDistance2("___XMJYAUZ___"s, "__MZJAWXU___"s, dldo_), 7U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("0123456789"s, "0123456789"s, dldo_),
+                0U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("Sunday"s, "Saturday"s, dldo_), 3U);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2("CA"s, "ABC"s, dldo_), 3U);
+}
 }  // namespace
@@ -0,0 +1,77 @@
+#include <string>
+#include <tlo-cpp/damerau-levenshtein.hpp>
+#include <tlo-cpp/distance-matrix.hpp>
+#include <tlo-cpp/lcs.hpp>
+#include <tlo-cpp/levenshtein.hpp>
+#include <tlo-cpp/test.hpp>
+#include <vector>
+
+#include "random-strings.hpp"
+
+namespace {
+// Returns numStrings pseudo-random strings of sizes 0, 1, ..., 12, 0, 1, ...
+std::vector<std::string> makeStrings(std::size_t numStrings) {
+  std::vector<std::string> strings;
+
+  for (std::size_t i = 0; i < numStrings; ++i) {
+    strings.push_back(
+        tlo::test::makeString(i % 13, 4, static_cast<unsigned>(i + 1)));
+  }
+
+  return strings;
+}
+
+TLO_TEST(condensedIndex) {
+  TLO_EXPECT_EQ(tlo::condensedSize(0), 0U);
+  TLO_EXPECT_EQ(tlo::condensedSize(1), 0U);
+  TLO_EXPECT_EQ(tlo::condensedSize(4), 6U);
+
+  TLO_EXPECT_EQ(tlo::condensedIndex(4, 0, 1), 0U);
+  TLO_EXPECT_EQ(tlo::condensedIndex(4, 0, 3), 2U);
+  TLO_EXPECT_EQ(tlo::condensedIndex(4, 1, 2), 3U);
+  TLO_EXPECT_EQ(tlo::condensedIndex(4, 2, 3), 5U);
+}
+
+TLO_TEST(pairwiseDistances) {
+  for (std::size_t numStrings : {0U, 1U, 2U, 17U, 40U}) {
+    const std::vector<std::string> strings = makeStrings(numStrings);
+
+    for (std::size_t numThreads : {1U, 4U}) {
+      auto levenshtein = tlo::pairwiseDistances(
+          strings,
+          [](const std::string &string1, const std::string &string2) {
+            return tlo::levenshteinDistance3(string1, string2);
+          },
+          numThreads);
+      auto damerLeven = tlo::pairwiseDistances(
+          strings,
+          [](const std::string &string1, const std::string &string2) {
+            return tlo::damerLevenDistance2(string1, string2);
+          },
+          numThreads);
+      auto lcs = tlo::pairwiseDistances(
+          strings,
+          [](const std::string &string1, const std::string &string2) {
+            return tlo::lcsLength3(string1, string2);
+          },
+          numThreads);
+
+      TLO_ASSERT_EQ(levenshtein.size(), tlo::condensedSize(numStrings));
+      TLO_ASSERT_EQ(damerLeven.size(), tlo::condensedSize(numStrings));
+      TLO_ASSERT_EQ(lcs.size(), tlo::condensedSize(numStrings));
+
+      for (std::size_t i = 0; i < numStrings; ++i) {
+        for (std::size_t j = i + 1; j < numStrings; ++j) {
+          std::size_t index = tlo::condensedIndex(numStrings, i, j);
+
+          TLO_EXPECT_EQ(levenshtein[index],
+                        tlo::levenshteinDistance1(strings[i], strings[j]));
+          TLO_EXPECT_EQ(damerLeven[index],
+                        tlo::damerLevenDistance1(strings[i], strings[j]));
+          TLO_EXPECT_EQ(lcs[index], tlo::lcsLength1(strings[i], strings[j]));
+        }
+      }
+    }
+  }
+}
+}  // namespace
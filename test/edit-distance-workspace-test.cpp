@@ -0,0 +1,76 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <tlo-cpp/damerau-levenshtein.hpp>
+#include <tlo-cpp/edit-distance-workspace.hpp>
+#include <tlo-cpp/lcs.hpp>
+#include <tlo-cpp/levenshtein.hpp>
+#include <tlo-cpp/test.hpp>
+#include <vector>
+
+namespace {
+using namespace std::string_literals;
+
+TLO_TEST(EditDistanceWorkspace_reuse) {
+  tlo::EditDistanceWorkspace workspace;
+  const auto long1 = std::string(300, 'a') + "ba"s;
+  const auto long2 = std::string(300, 'a') + "ab"s;
+
+  TLO_EXPECT_EQ(tlo::levenshteinDistance2WithWorkspace_(
+                    long1, 0, long1.size(), long2, 0, long2.size(), workspace),
+                2U);
+
+  const std::size_t *rowData = workspace.row().data();
+
+  TLO_EXPECT_EQ(tlo::levenshteinDistance2WithWorkspace_(
+                    "sitting"s, 0, 7, "kitten"s, 0, 6, workspace),
+                3U);
+  TLO_EXPECT_EQ(tlo::lcsLength2WithWorkspace_("GAC"s, 0, 3, "AGCAT"s, 0, 5,
+                                              workspace),
+                (tlo::LcsLengthResult{2, 4}));
+  TLO_EXPECT_EQ(workspace.row().data(), rowData);
+
+  TLO_EXPECT_EQ(tlo::damerLevenDistance1WithWorkspace_(
+                    long1, 0, long1.size(), long2, 0, long2.size(), workspace),
+                1U);
+
+  const std::uint16_t *cellData = workspace.cells<std::uint16_t>().data();
+
+  TLO_EXPECT_EQ(tlo::damerLevenDistance1WithWorkspace_(
+                    long1, 1, 299, long2, 0, 290, workspace),
+                9U);
+  TLO_EXPECT_EQ(workspace.cells<std::uint16_t>().data(), cellData);
+  TLO_EXPECT_EQ(tlo::damerLevenDistance1WithWorkspace_("CA"s, 0, 2, "ABC"s, 0,
+                                                       3, workspace),
+                2U);
+
+  const std::vector<int> tokens1{1, 2, 3, 4};
+  const std::vector<int> tokens2{2, 1, 3, 5};
+
+  TLO_EXPECT_EQ(tlo::damerLevenDistance1WithWorkspace_(tokens1, 0, 4, tokens2,
+                                                       0, 4, workspace),
+                2U);
+
+  workspace.release();
+  TLO_EXPECT_EQ(workspace.row().capacity(), 0U);
+  TLO_EXPECT_EQ(workspace.cells<std::uint16_t>().capacity(), 0U);
+}
+
+TLO_TEST(EditDistanceWorkspace_threadLocal) {
+  tlo::EditDistanceWorkspace *mainWorkspace =
+      &tlo::EditDistanceWorkspace::threadLocal();
+  tlo::EditDistanceWorkspace *otherWorkspace = nullptr;
+
+  std::thread thread(
+      [&] { otherWorkspace = &tlo::EditDistanceWorkspace::threadLocal(); });
+
+  thread.join();
+
+  TLO_EXPECT_EQ(&tlo::EditDistanceWorkspace::threadLocal(), mainWorkspace);
+  TLO_EXPECT_NE(otherWorkspace, mainWorkspace);
+
+  TLO_EXPECT_EQ(tlo::levenshteinDistance2("Sunday"s, "Saturday"s), 3U);
+  TLO_EXPECT_GE(mainWorkspace->row().capacity(), 7U);
+}
+}  // namespace
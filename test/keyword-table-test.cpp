@@ -0,0 +1,67 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tlo-cpp/keyword-table.hpp>
+#include <tlo-cpp/levenshtein.hpp>
+#include <tlo-cpp/test.hpp>
+
+namespace {
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+constexpr std::string_view commands[] = {
+    "add"sv,    "branch"sv, "checkout"sv, "cherry-pick"sv, "clone"sv,
+    "commit"sv, "diff"sv,   "fetch"sv,    "log"sv,         "merge"sv,
+    "pull"sv,   "push"sv,   "rebase"sv,   "reset"sv,       "status"sv};
+
+constexpr auto commandTable = tlo::makeKeywordTable<16>(commands);
+
+static_assert(commandTable.size() == 15);
+static_assert(commandTable.distance(10, 11) == 2);
+static_assert(commandTable.nearest("comit"sv).index == 5);
+static_assert(commandTable.nearest("comit"sv).distance == 1);
+static_assert(commandTable.nearest("stauts"sv).index == 14);
+
+TLO_TEST(KeywordTable) {
+  TLO_EXPECT_EQ(commandTable.keyword(3), "cherry-pick"sv);
+
+  for (std::size_t i = 0; i < commandTable.size(); ++i) {
+    TLO_EXPECT_EQ(commandTable.distance(i, i), 0U);
+
+    for (std::size_t j = 0; j < commandTable.size(); ++j) {
+      TLO_EXPECT_EQ(commandTable.distance(i, j),
+                    tlo::levenshteinDistance2(std::string(commands[i]),
+                                              std::string(commands[j])));
+    }
+  }
+}
+
+TLO_TEST(KeywordTable_nearest) {
+  const std::string inputs[] = {
+      "",       "ad",         "brnach",       "chekout", "cherrypick",
+      "clone",  "comit",      "dif",          "fetc",    "lg",
+      "merg",   "pul",        "psuh",         "rebsae",  "rest",
+      "statsu", "xyzzyxyzzy", std::string(100, 'p')};
+
+  for (const auto &input : inputs) {
+    std::size_t bestIndex = 0;
+    std::size_t bestDistance = tlo::levenshteinDistance2(
+        input, std::string(commandTable.keyword(0)));
+
+    for (std::size_t i = 1; i < commandTable.size(); ++i) {
+      std::size_t distance = tlo::levenshteinDistance2(
+          input, std::string(commandTable.keyword(i)));
+
+      if (distance < bestDistance) {
+        bestIndex = i;
+        bestDistance = distance;
+      }
+    }
+
+    const auto match = commandTable.nearest(input);
+
+    TLO_EXPECT_EQ(match.index, bestIndex);
+    TLO_EXPECT_EQ(match.distance, bestDistance);
+  }
+}
+}  // namespace
@@ -1,9 +1,21 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tlo-cpp/lcs.hpp>
 #include <tlo-cpp/test.hpp>
+#include <vector>
+
+#include "random-strings.hpp"
 
 namespace {
 using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+using tlo::test::makeString;
 
 tlo::LcsLengthResult result(std::size_t lcsLength, std::size_t lcsDistance) {
   return {lcsLength, lcsDistance};
@@ -30,6 +42,14 @@ TLO_TEST(lcsLength1) {
   TLO_EXPECT_EQ(tlo::lcsLength1("CA"s, "ABC"s), result(1, 3));
 }
 
+TLO_TEST(lcsLength1_wide_cells) {
+  TLO_EXPECT_EQ(tlo::lcsLength1(std::string(300, 'a'), std::string(280, 'a')),
+                result(280, 20));
+  TLO_EXPECT_EQ(tlo::lcsLength1(std::string(300, 'a') + "b"s,
+                                "b"s + std::string(256, 'a')),
+                result(256, 46));
+}
+
 TLO_TEST(lcsLength2) {
   TLO_EXPECT_EQ(tlo::lcsLength2(""s, ""s), result(0, 0));
   TLO_EXPECT_EQ(tlo::lcsLength2("GAC"s, ""s), result(0, 3));
@@ -51,6 +71,234 @@ TLO_TEST(lcsLength2) {
   TLO_EXPECT_EQ(tlo::lcsLength2("CA"s, "ABC"s), result(1, 3));
 }
 
+TLO_TEST(lcsLengthFixed) {
+  static_assert(tlo::lcsLengthFixed<8>(""sv, ""sv).lcsLength == 0);
+  static_assert(tlo::lcsLengthFixed<8>("sitting"sv, "kitten"sv).lcsLength ==
+                4);
+  static_assert(tlo::lcsLengthFixed<8>("sitting"sv, "kitten"sv).lcsDistance ==
+                5);
+  static_assert(tlo::lcsLengthFixed<3>(std::array<char, 3>{'G', 'A', 'C'},
+                                       std::array<char, 3>{'A', 'G', 'C'})
+                    .lcsLength == 2);
+
+  const char *strings[] = {"",
+                           "GAC",
+                           "AGCAT",
+                           "XMJYAUZ",
+                           "MZJAWXU",
+                           "___XMJYAUZ___",
+                           "__MZJAWXU___-",
+                           "aaabbb___bbbccc",
+                           "Sunday",
+                           "Saturday"};
+
+  for (const char *string1 : strings) {
+    for (const char *string2 : strings) {
+      TLO_EXPECT_EQ(
+          tlo::lcsLengthFixed<16>(std::string_view(string1),
+                                  std::string_view(string2)),
+          tlo::lcsLength2(std::string(string1), std::string(string2)));
+    }
+  }
+
+  // Only the shorter sequence has to fit.
+  TLO_EXPECT_EQ(tlo::lcsLengthFixed<4>(std::string(300, 'a'), "abba"s),
+                result(2, 300));
+
+  bool threw = false;
+
+  try {
+    tlo::lcsLengthFixed<4>("kitten"sv, "sitting"sv);
+  } catch (const std::length_error &) {
+    threw = true;
+  }
+
+  TLO_EXPECT(threw);
+}
+
+TLO_TEST(lcsLengthWavefront) {
+  TLO_EXPECT_EQ(tlo::lcsLengthWavefront(""s, "AGCAT"s), result(0, 5));
+  TLO_EXPECT_EQ(tlo::lcsLengthWavefront("sitting"s, "kitten"s), result(4, 5));
+
+  unsigned seed = 1U;
+
+  for (std::size_t size1 : {1U, 5U, 64U, 200U}) {
+    for (std::size_t size2 : {1U, 7U, 130U}) {
+      const auto string1 = makeString(size1 + 3, 4, seed++);
+      const auto string2 = makeString(size2 + 2, 4, seed++);
+      const auto expected =
+          tlo::lcsLength2_(string1, 3, size1, string2, 2, size2);
+
+      for (std::size_t tileSize : {1U, 3U, 16U, 1000U}) {
+        for (std::size_t numThreads : {1U, 3U}) {
+          TLO_EXPECT_EQ(
+              tlo::lcsLengthWavefrontWithThreads_(string1, 3, size1, string2,
+                                                  2, size2, numThreads,
+                                                  tileSize),
+              expected);
+        }
+      }
+    }
+  }
+}
+
+TLO_TEST(LcsRowStream) {
+  const auto sequence2 = "__MZJAWXU___"s;
+  const auto sequence1 = "___XMJYAUZ___"s;
+  tlo::LcsRowStream<std::string> rowStream(sequence2);
+
+  TLO_EXPECT_EQ(rowStream.result(), result(0, sequence2.size()));
+
+  for (std::size_t i = 0; i < sequence1.size(); ++i) {
+    rowStream.push(sequence1[i]);
+    TLO_EXPECT_EQ(rowStream.size1(), i + 1);
+    TLO_EXPECT_EQ(rowStream.result(),
+                  tlo::lcsLength2(sequence1.substr(0, i + 1), sequence2));
+  }
+
+  tlo::LcsRowStream<std::string> partRowStream(sequence2, 2, 7);
+
+  partRowStream.push(sequence1.begin(), sequence1.end());
+  TLO_EXPECT_EQ(partRowStream.result(),
+                tlo::lcsLength2_(sequence1, 0, sequence1.size(), sequence2, 2,
+                                 7));
+}
+
+TLO_TEST(lcsDistanceBounded) {
+  TLO_EXPECT_EQ(tlo::lcsDistanceBounded(""s, ""s, 0), 0U);
+  TLO_EXPECT_EQ(tlo::lcsDistanceBounded("GAC"s, ""s, 3), 3U);
+  TLO_EXPECT_EQ(tlo::lcsDistanceBounded("GAC"s, ""s, 2), 3U);
+  TLO_EXPECT_EQ(tlo::lcsDistanceBounded("ba"s, "a"s, 1), 1U);
+  TLO_EXPECT_EQ(tlo::lcsDistanceBounded("GAC"s, "AGCAT"s, 4), 4U);
+  TLO_EXPECT_EQ(tlo::lcsDistanceBounded("GAC"s, "AGCAT"s, 3), 4U);
+  TLO_EXPECT_EQ(tlo::lcsDistanceBounded("sitting"s, "kitten"s, 5), 5U);
+  TLO_EXPECT_EQ(tlo::lcsDistanceBounded("sitting"s, "kitten"s, 4), 5U);
+
+  std::string sequence1;
+  std::string sequence2;
+
+  for (std::size_t i = 0; i < 300; ++i) {
+    sequence1.push_back(static_cast<char>('a' + i * 7 % 5));
+    sequence2.push_back(static_cast<char>('a' + i * 3 % 4));
+  }
+
+  const std::size_t distance =
+      tlo::lcsLength2(sequence1, sequence2).lcsDistance;
+
+  for (std::size_t maxDistance : {0U, 10U, 200U, 250U, 300U, 600U}) {
+    TLO_EXPECT_EQ(tlo::lcsDistanceBounded(sequence1, sequence2, maxDistance),
+                  std::min(distance, maxDistance + 1));
+  }
+}
+
+TLO_TEST(lcsSimilarity) {
+  TLO_EXPECT_EQ(tlo::lcsSimilarity(""s, ""s), 1.0);
+  TLO_EXPECT_EQ(tlo::lcsSimilarity("GAC"s, "GAC"s, 1.0), 1.0);
+  TLO_EXPECT_EQ(tlo::lcsSimilarity("GAC"s, "XYZ"s), 0.0);
+  TLO_EXPECT_EQ(tlo::lcsSimilarity("GAC"s, "AGCAT"s), 0.5);
+  TLO_EXPECT_EQ(tlo::lcsSimilarity("GAC"s, "AGCAT"s, 0.5), 0.5);
+  TLO_EXPECT_EQ(tlo::lcsSimilarity("GAC"s, "AGCAT"s, 0.6), 0.0);
+  TLO_EXPECT_EQ(tlo::lcsSimilarity("sitting"s, "kitten"s),
+                1.0 - 5.0 / 13.0);
+  TLO_EXPECT_EQ(tlo::lcsSimilarity("GAC"s, "GAC"s, 1.5), 0.0);
+}
+
+TLO_TEST(lcsLengthSimd) {
+  const auto &lcsls = tlo::lcsLengthSimd<std::string>;
+
+  TLO_EXPECT_EQ(lcsls(""s, ""s), result(0, 0));
+  TLO_EXPECT_EQ(lcsls("GAC"s, ""s), result(0, 3));
+  TLO_EXPECT_EQ(lcsls(""s, "AGCAT"s), result(0, 5));
+  TLO_EXPECT_EQ(lcsls("GAC"s, "AGCAT"s), result(2, 4));
+  TLO_EXPECT_EQ(lcsls("XMJYAUZ"s, "MZJAWXU"s), result(4, 6));
+  TLO_EXPECT_EQ(lcsls("___XMJYAUZ___"s, "__MZJAWXU___"s), result(9, 7));
+  TLO_EXPECT_EQ(lcsls("__XMJYAUZ___"s, "___MZJAWXU___-"s), result(9, 8));
+  TLO_EXPECT_EQ(lcsls("0123456789"s, "0123456789"s), result(10, 0));
+  TLO_EXPECT_EQ(lcsls("01234567"s, "abcdefghij"s), result(0, 18));
+  TLO_EXPECT_EQ(lcsls("aaabbb"s, "aaabbb___bbbccc"s), result(6, 9));
+  TLO_EXPECT_EQ(lcsls("bbbccc"s, "aaabbb___bbbccc"s), result(6, 9));
+  TLO_EXPECT_EQ(lcsls("aaabbbccc"s, "aaabbb___bbbccc"s), result(9, 6));
+  TLO_EXPECT_EQ(lcsls("sitting"s, "kitten"s), result(4, 5));
+  TLO_EXPECT_EQ(lcsls("Sunday"s, "Saturday"s), result(5, 4));
+  TLO_EXPECT_EQ(lcsls("CA"s, "ABC"s), result(1, 3));
+}
+
+TLO_TEST(lcsLengthBitParallel) {
+  const auto &lcslb = tlo::lcsLengthBitParallel<std::string>;
+
+  TLO_EXPECT_EQ(lcslb(""s, ""s), result(0, 0));
+  TLO_EXPECT_EQ(lcslb("GAC"s, ""s), result(0, 3));
+  TLO_EXPECT_EQ(lcslb(""s, "AGCAT"s), result(0, 5));
+  TLO_EXPECT_EQ(lcslb("GAC"s, "AGCAT"s), result(2, 4));
+  TLO_EXPECT_EQ(lcslb("XMJYAUZ"s, "MZJAWXU"s), result(4, 6));
+  TLO_EXPECT_EQ(lcslb("___XMJYAUZ___"s, "__MZJAWXU___"s), result(9, 7));
+  TLO_EXPECT_EQ(lcslb("__XMJYAUZ___"s, "___MZJAWXU___-"s), result(9, 8));
+  TLO_EXPECT_EQ(lcslb("0123456789"s, "0123456789"s), result(10, 0));
+  TLO_EXPECT_EQ(lcslb("01234567"s, "abcdefghij"s), result(0, 18));
+  TLO_EXPECT_EQ(lcslb("aaabbb"s, "aaabbb___bbbccc"s), result(6, 9));
+  TLO_EXPECT_EQ(lcslb("bbbccc"s, "aaabbb___bbbccc"s), result(6, 9));
+  TLO_EXPECT_EQ(lcslb("aaabbbccc"s, "aaabbb___bbbccc"s), result(9, 6));
+  TLO_EXPECT_EQ(lcslb("sitting"s, "kitten"s), result(4, 5));
+  TLO_EXPECT_EQ(lcslb("Sunday"s, "Saturday"s), result(5, 4));
+  TLO_EXPECT_EQ(lcslb("CA"s, "ABC"s), result(1, 3));
+}
+
+TLO_TEST(lcsLengthBitParallel_long_sequences) {
+  std::string sequence1;
+  std::string sequence2;
+
+  for (std::size_t i = 0; i < 300; ++i) {
+    sequence1.push_back(static_cast<char>('a' + i * 7 % 5));
+    sequence2.push_back(static_cast<char>('a' + i * 3 % 4));
+  }
+
+  TLO_EXPECT_EQ(tlo::lcsLengthBitParallel(sequence1, sequence2),
+                tlo::lcsLength2(sequence1, sequence2));
+  TLO_EXPECT_EQ(tlo::lcsLengthBitParallel(sequence1, sequence1 + "xyz"s),
+                result(300, 3));
+  TLO_EXPECT_EQ(tlo::lcsLengthBitParallel(std::vector<int>(130, 1),
+                                          std::vector<int>(200, 1)),
+                result(130, 70));
+}
+
+TLO_TEST(lcsLengthMyersOnd) {
+  const auto &lcslm = tlo::lcsLengthMyersOnd<std::string>;
+
+  TLO_EXPECT_EQ(lcslm(""s, ""s), result(0, 0));
+  TLO_EXPECT_EQ(lcslm("GAC"s, ""s), result(0, 3));
+  TLO_EXPECT_EQ(lcslm(""s, "AGCAT"s), result(0, 5));
+  TLO_EXPECT_EQ(lcslm("GAC"s, "AGCAT"s), result(2, 4));
+  TLO_EXPECT_EQ(lcslm("XMJYAUZ"s, "MZJAWXU"s), result(4, 6));
+  TLO_EXPECT_EQ(lcslm("___XMJYAUZ___"s, "__MZJAWXU___"s), result(9, 7));
+  TLO_EXPECT_EQ(lcslm("__XMJYAUZ___"s, "___MZJAWXU___-"s), result(9, 8));
+  TLO_EXPECT_EQ(lcslm("0123456789"s, "0123456789"s), result(10, 0));
+  TLO_EXPECT_EQ(lcslm("01234567"s, "abcdefghij"s), result(0, 18));
+  TLO_EXPECT_EQ(lcslm("aaabbb"s, "aaabbb___bbbccc"s), result(6, 9));
+  TLO_EXPECT_EQ(lcslm("bbbccc"s, "aaabbb___bbbccc"s), result(6, 9));
+  TLO_EXPECT_EQ(lcslm("aaabbbccc"s, "aaabbb___bbbccc"s), result(9, 6));
+  TLO_EXPECT_EQ(lcslm("sitting"s, "kitten"s), result(4, 5));
+  TLO_EXPECT_EQ(lcslm("Sunday"s, "Saturday"s), result(5, 4));
+  TLO_EXPECT_EQ(lcslm("CA"s, "ABC"s), result(1, 3));
+}
+
+TLO_TEST(lcsLengthMyersOnd_line_hashes) {
+  std::vector<std::uint64_t> lines1;
+
+  for (std::uint64_t i = 0; i < 1000; ++i) {
+    lines1.push_back(i * 2654435761U);
+  }
+
+  std::vector<std::uint64_t> lines2 = lines1;
+
+  lines2.erase(lines2.begin() + 100, lines2.begin() + 103);
+  lines2.insert(lines2.begin() + 500, 7);
+  lines2[900] = 11;
+
+  TLO_EXPECT_EQ(tlo::lcsLengthMyersOnd(lines1, lines2), result(996, 6));
+  TLO_EXPECT_EQ(tlo::lcsLengthMyersOnd(lines1, lines2),
+                tlo::lcsLength2(lines1, lines2));
+}
+
 TLO_TEST(lcsLength3_with_lcsLength1) {
   const auto &lcsl1_ = tlo::lcsLength1_<std::string>;
 
@@ -98,4 +346,46 @@ TLO_TEST(lcsLength3_with_lcsLength2) {
   TLO_EXPECT_EQ(tlo::lcsLength3("Sunday"s, "Saturday"s), result(5, 4));
   TLO_EXPECT_EQ(tlo::lcsLength3("CA"s, "ABC"s), result(1, 3));
 }
+
+TLO_TEST(lcsLength3_with_lcsLengthMyersOnd) {
+  const auto &lcslm_ = tlo::lcsLengthMyersOnd_<std::string>;
+
+  TLO_EXPECT_EQ(tlo::lcsLength3(""s, ""s, lcslm_), result(0, 0));
+  TLO_EXPECT_EQ(tlo::lcsLength3("GAC"s, "AGCAT"s, lcslm_), result(2, 4));
+  TLO_EXPECT_EQ(tlo::lcsLength3("___XMJYAUZ___"s, "__MZJAWXU___"s, lcslm_),
+                result(9, 7));
+  TLO_EXPECT_EQ(tlo::lcsLength3("0123456789"s, "0123456789"s, lcslm_),
+                result(10, 0));
+  TLO_EXPECT_EQ(tlo::lcsLength3("aaabbbccc"s, "aaabbb___bbbccc"s, lcslm_),
+                result(9, 6));
+  TLO_EXPECT_EQ(tlo::lcsLength3("Sunday"s, "Saturday"s, lcslm_), result(5, 4));
+}
+
+TLO_TEST(lcsLength3_with_lcsLengthWavefront) {
+  const auto &lcslw_ = tlo::lcsLengthWavefront_<std::string>;
+
+  TLO_EXPECT_EQ(tlo::lcsLength3(""s, ""s, lcslw_), result(0, 0));
+  TLO_EXPECT_EQ(tlo::lcsLength3("GAC"s, "AGCAT"s, lcslw_), result(2, 4));
+  TLO_EXPECT_EQ(tlo::lcsLength3("___XMJYAUZ___"s, "__MZJAWXU___"s, lcslw_),
+                result(9, 7));
+  TLO_EXPECT_EQ(tlo::lcsLength3("0123456789"s, "0123456789"s, lcslw_),
+                result(10, 0));
+  TLO_EXPECT_EQ(tlo::lcsLength3("aaabbbccc"s, "aaabbb___bbbccc"s, lcslw_),
+                result(9, 6));
+  TLO_EXPECT_EQ(tlo::lcsLength3("Sunday"s, "Saturday"s, lcslw_), result(5, 4));
+}
+
+TLO_TEST(lcsLength3_with_lcsLengthBitParallel) {
+  const auto &lcslb_ = tlo::lcsLengthBitParallel_<std::string>;
+
+  TLO_EXPECT_EQ(tlo::lcsLength3(""s, ""s, lcslb_), result(0, 0));
+  TLO_EXPECT_EQ(tlo::lcsLength3("GAC"s, "AGCAT"s, lcslb_), result(2, 4));
+  TLO_EXPECT_EQ(tlo::lcsLength3("___XMJYAUZ___"s, "__MZJAWXU___"s, lcslb_),
+                result(9, 7));
+  TLO_EXPECT_EQ(tlo::lcsLength3("0123456789"s, "0123456789"s, lcslb_),
+                result(10, 0));
+  TLO_EXPECT_EQ(tlo::lcsLength3("aaabbbccc"s, "aaabbb___bbbccc"s, lcslb_),
+                result(9, 6));
+  TLO_EXPECT_EQ(tlo::lcsLength3("Sunday"s, "Saturday"s, lcslb_), result(5, 4));
+}
 }  // namespace
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <tlo-cpp/levenshtein-automaton.hpp>
+#include <tlo-cpp/levenshtein.hpp>
+#include <tlo-cpp/test.hpp>
+#include <utility>
+#include <vector>
+
+#include "random-strings.hpp"
+
+namespace {
+using namespace std::string_literals;
+
+using tlo::test::makeString;
+
+using Matches = std::vector<std::pair<std::size_t, std::size_t>>;
+
+Matches findMatches(const tlo::LevenshteinAutomaton<char> &automaton,
+                    const std::vector<std::string> &sortedTerms) {
+  Matches matches;
+
+  tlo::forEachLevenshteinMatch(automaton, sortedTerms,
+                               [&](std::size_t index, std::size_t distance) {
+                                 matches.emplace_back(index, distance);
+                               });
+  return matches;
+}
+
+// Returns the distance reported by automaton after reading all of sequence.
+std::size_t readAll(const tlo::LevenshteinAutomaton<char> &automaton,
+                    const std::string &sequence) {
+  auto state = automaton.start();
+
+  for (char c : sequence) {
+    state = automaton.next(state, c);
+  }
+
+  return automaton.distance(state);
+}
+
+TLO_TEST(LevenshteinAutomaton) {
+  tlo::LevenshteinAutomaton<char> automaton("kitten"s, 3);
+
+  TLO_EXPECT_EQ(automaton.maxDistance(), 3U);
+  TLO_EXPECT_EQ(readAll(automaton, "kitten"s), 0U);
+  TLO_EXPECT_EQ(readAll(automaton, "sitting"s), 3U);
+  TLO_EXPECT_EQ(readAll(automaton, "mitten"s), 1U);
+  TLO_EXPECT_EQ(readAll(automaton, ""s), 4U);
+  TLO_EXPECT_EQ(readAll(automaton, "xxxxxxxx"s), 4U);
+  TLO_EXPECT_EQ(automaton.next(tlo::LevenshteinAutomaton<char>::DEAD, 'k'),
+                tlo::LevenshteinAutomaton<char>::DEAD);
+
+  tlo::LevenshteinAutomaton<char> empty(""s, 1);
+
+  TLO_EXPECT_EQ(readAll(empty, ""s), 0U);
+  TLO_EXPECT_EQ(readAll(empty, "a"s), 1U);
+  TLO_EXPECT_EQ(readAll(empty, "ab"s), 2U);
+  TLO_EXPECT_EQ(empty.numStates(), 3U);
+}
+
+TLO_TEST(LevenshteinAutomaton_agrees_with_levenshteinDistance2) {
+  for (unsigned seed = 0; seed < 50; ++seed) {
+    std::string query = makeString(seed % 9, 3, seed);
+
+    for (std::size_t maxDistance = 0; maxDistance <= 3; ++maxDistance) {
+      tlo::LevenshteinAutomaton<char> automaton(query, maxDistance);
+
+      for (unsigned termSeed = 0; termSeed < 50; ++termSeed) {
+        std::string term = makeString(termSeed % 11, 4, termSeed + 100);
+
+        TLO_EXPECT_EQ(readAll(automaton, term),
+                      std::min(tlo::levenshteinDistance2(query, term),
+                               maxDistance + 1));
+      }
+    }
+  }
+}
+
+TLO_TEST(forEachLevenshteinMatch) {
+  std::vector<std::string> terms = {"", "a", "boo", "book", "booking",
+                                    "books", "boon", "cook", "cooking"};
+
+  TLO_EXPECT(findMatches(tlo::LevenshteinAutomaton<char>("book"s, 1), terms) ==
+             Matches({{2, 1}, {3, 0}, {5, 1}, {6, 1}, {7, 1}}));
+  TLO_EXPECT(findMatches(tlo::LevenshteinAutomaton<char>("ab"s, 2), terms) ==
+             Matches({{0, 2}, {1, 1}}));
+  TLO_EXPECT(findMatches(tlo::LevenshteinAutomaton<char>("book"s, 1), {}) ==
+             Matches());
+
+  for (unsigned seed = 0; seed < 20; ++seed) {
+    std::vector<std::string> sortedTerms;
+
+    for (unsigned termSeed = 0; termSeed < 300; ++termSeed) {
+      sortedTerms.push_back(
+          makeString(termSeed % 8, 3, seed * 1000 + termSeed));
+    }
+
+    std::sort(sortedTerms.begin(), sortedTerms.end());
+
+    std::string query = makeString(2 + seed % 5, 3, seed + 5000);
+
+    for (std::size_t maxDistance = 0; maxDistance <= 3; ++maxDistance) {
+      tlo::LevenshteinAutomaton<char> automaton(query, maxDistance);
+      Matches expected;
+
+      for (std::size_t i = 0; i < sortedTerms.size(); ++i) {
+        std::size_t distance = tlo::levenshteinDistance2(query, sortedTerms[i]);
+
+        if (distance <= maxDistance) {
+          expected.emplace_back(i, distance);
+        }
+      }
+
+      TLO_EXPECT(findMatches(automaton, sortedTerms) == expected);
+    }
+  }
+}
+}  // namespace
@@ -1,9 +1,60 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tlo-cpp/levenshtein.hpp>
 #include <tlo-cpp/test.hpp>
+#include <utility>
+#include <vector>
+
+#include "random-strings.hpp"
 
 namespace {
 using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+using tlo::test::makeString;
+
+// Costs 0 for substituting letters that only differ in case.
+struct CaseInsensitiveCosts : tlo::UnitLevenshteinCosts {
+  static char toLower(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+  }
+
+  Cost substitution(char from, char to) const {
+    return toLower(from) == toLower(to) ? 0 : 1;
+  }
+};
+
+// Costs 0.5 for substituting neighbors on the same keyboard row and 2 for
+// insertions.
+struct KeyboardCosts {
+  using Cost = double;
+
+  Cost insertion(char) const { return 2; }
+
+  Cost deletion(char) const { return 1; }
+
+  Cost substitution(char from, char to) const {
+    static const std::string rows = "qwertyuiop asdfghjkl zxcvbnm";
+
+    if (from == to) {
+      return 0;
+    }
+
+    std::size_t index = rows.find(from);
+
+    if (index != std::string::npos &&
+        ((index > 0 && rows[index - 1] == to) ||
+         (index + 1 < rows.size() && rows[index + 1] == to))) {
+      return 0.5;
+    }
+
+    return 1;
+  }
+};
 
 TLO_TEST(levenshteinDistance1) {
   TLO_EXPECT_EQ(tlo::levenshteinDistance1(""s, ""s), 0U);
@@ -26,6 +77,18 @@ TLO_TEST(levenshteinDistance1) {
   TLO_EXPECT_EQ(tlo::levenshteinDistance1("CA"s, "ABC"s), 3U);
 }
 
+TLO_TEST(levenshteinDistance1_wide_cells) {
+  for (std::size_t size : {255U, 256U, 300U}) {
+    std::string string1 = makeString(size, 4, 10);
+    std::string string2 = makeString(size - 20, 4, 11);
+
+    TLO_EXPECT_EQ(tlo::levenshteinDistance1(string1, string2),
+                  tlo::levenshteinDistance2(string1, string2));
+  }
+
+  TLO_EXPECT_EQ(tlo::levenshteinDistance1(std::string(300, 'a'), "b"s), 300U);
+}
+
 TLO_TEST(levenshteinDistance2) {
   TLO_EXPECT_EQ(tlo::levenshteinDistance2(""s, ""s), 0U);
   TLO_EXPECT_EQ(tlo::levenshteinDistance2("GAC"s, ""s), 3U);
@@ -47,6 +110,353 @@ TLO_TEST(levenshteinDistance2) {
   TLO_EXPECT_EQ(tlo::levenshteinDistance2("CA"s, "ABC"s), 3U);
 }
 
+TLO_TEST(levenshteinDistanceFixed) {
+  static_assert(tlo::levenshteinDistanceFixed<8>(""sv, ""sv) == 0);
+  static_assert(tlo::levenshteinDistanceFixed<8>("sitting"sv, "kitten"sv) ==
+                3);
+  static_assert(tlo::levenshteinDistanceFixed<4>("CA"sv, "ABC"sv) == 3);
+  static_assert(tlo::levenshteinDistanceFixed<3>(
+                    std::array<char, 3>{'G', 'A', 'C'},
+                    std::array<char, 3>{'C', 'A', 'T'}) == 2);
+
+  const char *strings[] = {"",
+                           "GAC",
+                           "AGCAT",
+                           "XMJYAUZ",
+                           "MZJAWXU",
+                           "___XMJYAUZ___",
+                           "__MZJAWXU___-",
+                           "aaabbb___bbbccc",
+                           "Sunday",
+                           "Saturday"};
+
+  for (const char *string1 : strings) {
+    for (const char *string2 : strings) {
+      TLO_EXPECT_EQ(
+          tlo::levenshteinDistanceFixed<16>(std::string_view(string1),
+                                            std::string_view(string2)),
+          tlo::levenshteinDistance2(std::string(string1),
+                                    std::string(string2)));
+    }
+  }
+
+  // Only the shorter sequence has to fit.
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceFixed<4>(std::string(300, 'a'),
+                                                 "abba"s),
+                298U);
+
+  bool threw = false;
+
+  try {
+    tlo::levenshteinDistanceFixed<4>("kitten"sv, "sitting"sv);
+  } catch (const std::length_error &) {
+    threw = true;
+  }
+
+  TLO_EXPECT(threw);
+}
+
+TLO_TEST(levenshteinDistanceWavefront) {
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceWavefront(""s, "AGCAT"s), 5U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceWavefront("sitting"s, "kitten"s), 3U);
+
+  unsigned seed = 1U;
+
+  for (std::size_t size1 : {1U, 5U, 64U, 200U}) {
+    for (std::size_t size2 : {1U, 7U, 130U}) {
+      const auto string1 = makeString(size1 + 3, 4, seed++);
+      const auto string2 = makeString(size2 + 2, 4, seed++);
+      const std::size_t expected =
+          tlo::levenshteinDistance2_(string1, 3, size1, string2, 2, size2);
+
+      for (std::size_t tileSize : {1U, 3U, 16U, 1000U}) {
+        for (std::size_t numThreads : {1U, 3U}) {
+          TLO_EXPECT_EQ(tlo::levenshteinDistanceWavefrontWithThreads_(
+                            string1, 3, size1, string2, 2, size2, numThreads,
+                            tileSize),
+                        expected);
+        }
+      }
+    }
+  }
+}
+
+TLO_TEST(LevenshteinRowStream) {
+  const auto sequence2 = "__MZJAWXU___"s;
+  const auto sequence1 = "___XMJYAUZ___"s;
+  tlo::LevenshteinRowStream<std::string> rowStream(sequence2);
+
+  TLO_EXPECT_EQ(rowStream.distance(), sequence2.size());
+
+  for (std::size_t i = 0; i < sequence1.size(); ++i) {
+    rowStream.push(sequence1[i]);
+    TLO_EXPECT_EQ(rowStream.size1(), i + 1);
+    TLO_EXPECT_EQ(rowStream.distance(),
+                  tlo::levenshteinDistance2(sequence1.substr(0, i + 1),
+                                            sequence2));
+  }
+
+  const auto long1 = makeString(3000, 4, 1U);
+  const auto long2 = makeString(200, 4, 2U);
+  tlo::LevenshteinRowStream<std::string> longRowStream(long2, 50, 100);
+
+  longRowStream.push(long1.begin(), long1.end());
+  TLO_EXPECT_EQ(longRowStream.distance(),
+                tlo::levenshteinDistance2_(long1, 0, long1.size(), long2, 50,
+                                           100));
+}
+
+TLO_TEST(levenshteinDistanceWeighted_with_UnitLevenshteinCosts) {
+  const auto &ldw = tlo::levenshteinDistanceWeighted<tlo::UnitLevenshteinCosts,
+                                                     std::string>;
+
+  TLO_EXPECT_EQ(ldw(""s, ""s, {}), 0U);
+  TLO_EXPECT_EQ(ldw("GAC"s, ""s, {}), 3U);
+  TLO_EXPECT_EQ(ldw(""s, "AGCAT"s, {}), 5U);
+  TLO_EXPECT_EQ(ldw("GAC"s, "AGCAT"s, {}), 3U);
+  TLO_EXPECT_EQ(ldw("XMJYAUZ"s, "MZJAWXU"s, {}), 6U);
+  TLO_EXPECT_EQ(ldw("___XMJYAUZ___"s, "__MZJAWXU___"s, {}), 7U);
+  TLO_EXPECT_EQ(ldw("__XMJYAUZ___"s, "___MZJAWXU___-"s, {}), 7U);
+  TLO_EXPECT_EQ(ldw("0123456789"s, "0123456789"s, {}), 0U);
+  TLO_EXPECT_EQ(ldw("01234567"s, "abcdefghij"s, {}), 10U);
+  TLO_EXPECT_EQ(ldw("aaabbb"s, "aaabbb___bbbccc"s, {}), 9U);
+  TLO_EXPECT_EQ(ldw("bbbccc"s, "aaabbb___bbbccc"s, {}), 9U);
+  TLO_EXPECT_EQ(ldw("aaabbbccc"s, "aaabbb___bbbccc"s, {}), 6U);
+  TLO_EXPECT_EQ(ldw("sitting"s, "kitten"s, {}), 3U);
+  TLO_EXPECT_EQ(ldw("Sunday"s, "Saturday"s, {}), 3U);
+  TLO_EXPECT_EQ(ldw("CA"s, "ABC"s, {}), 3U);
+}
+
+TLO_TEST(levenshteinDistanceWeighted_with_custom_costs) {
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceWeighted<CaseInsensitiveCosts>(
+                    "Sunday"s, "sUNDAY"s),
+                0U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceWeighted<CaseInsensitiveCosts>(
+                    "Kitten"s, "sitting"s),
+                3U);
+
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistanceWeighted<KeyboardCosts>("hello"s, "hello"s),
+      0.0);
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistanceWeighted<KeyboardCosts>("hello"s, "jello"s),
+      0.5);
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistanceWeighted<KeyboardCosts>("hello"s, "yello"s),
+      1.0);
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistanceWeighted<KeyboardCosts>("abc"s, "abcd"s), 2.0);
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistanceWeighted<KeyboardCosts>("abcd"s, "abc"s), 1.0);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceWeighted_<KeyboardCosts>(
+                    "xxhelloxx"s, 2, 5, "jelly"s, 0, 5),
+                1.5);
+}
+
+TLO_TEST(levenshteinDistanceBounded) {
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceBounded(""s, ""s, 0), 0U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceBounded("GAC"s, ""s, 3), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceBounded("GAC"s, ""s, 2), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceBounded(""s, "AGCAT"s, 1), 2U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceBounded("GAC"s, "AGCAT"s, 3), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceBounded("GAC"s, "AGCAT"s, 2), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceBounded("XMJYAUZ"s, "MZJAWXU"s, 6),
+                6U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceBounded("XMJYAUZ"s, "MZJAWXU"s, 2),
+                3U);
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistanceBounded("0123456789"s, "0123456789"s, 0), 0U);
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistanceBounded("01234567"s, "abcdefghij"s, 100), 10U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceBounded("sitting"s, "kitten"s, 3), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceBounded("sitting"s, "kitten"s, 2), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceBounded("Sunday"s, "Saturday"s, 4),
+                3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceBounded("CA"s, "ABC"s, 1), 2U);
+}
+
+TLO_TEST(levenshteinDistanceBounded_long_sequences) {
+  for (std::size_t size1 : {1U, 30U, 64U, 100U}) {
+    for (std::size_t size2 : {1U, 28U, 64U, 97U}) {
+      std::string string1 = makeString(size1, 3, 3);
+      std::string string2 = makeString(size2, 3, 4);
+      std::size_t distance = tlo::levenshteinDistance2(string1, string2);
+
+      for (std::size_t maxDistance : {0U, 1U, 2U, 5U, 20U, 60U, 200U}) {
+        TLO_EXPECT_EQ(
+            tlo::levenshteinDistanceBounded(string1, string2, maxDistance),
+            std::min(distance, maxDistance + 1));
+      }
+    }
+  }
+}
+
+TLO_TEST(levenshteinSimilarity) {
+  TLO_EXPECT_EQ(tlo::levenshteinSimilarity(""s, ""s), 1.0);
+  TLO_EXPECT_EQ(tlo::levenshteinSimilarity("GAC"s, "GAC"s, 1.0), 1.0);
+  TLO_EXPECT_EQ(tlo::levenshteinSimilarity("GAC"s, "XYZ"s), 0.0);
+  TLO_EXPECT_EQ(tlo::levenshteinSimilarity("sitting"s, "kitten"s),
+                1.0 - 3.0 / 7.0);
+  TLO_EXPECT_EQ(tlo::levenshteinSimilarity("sitting"s, "kitten"s, 0.5),
+                1.0 - 3.0 / 7.0);
+  TLO_EXPECT_EQ(tlo::levenshteinSimilarity("sitting"s, "kitten"s, 0.6), 0.0);
+  TLO_EXPECT_EQ(tlo::levenshteinSimilarity("abcdefghij"s, "abcdefgh__"s, 0.8),
+                0.8);
+  TLO_EXPECT_EQ(tlo::levenshteinSimilarity("GAC"s, "GAC"s, 1.5), 0.0);
+}
+
+TLO_TEST(levenshteinDistanceMyers) {
+  const auto &ldm = tlo::levenshteinDistanceMyers<std::string>;
+
+  TLO_EXPECT_EQ(ldm(""s, ""s), 0U);
+  TLO_EXPECT_EQ(ldm("GAC"s, ""s), 3U);
+  TLO_EXPECT_EQ(ldm(""s, "AGCAT"s), 5U);
+  TLO_EXPECT_EQ(ldm("GAC"s, "AGCAT"s), 3U);
+  TLO_EXPECT_EQ(ldm("XMJYAUZ"s, "MZJAWXU"s), 6U);
+  TLO_EXPECT_EQ(ldm("___XMJYAUZ___"s, "__MZJAWXU___"s), 7U);
+  TLO_EXPECT_EQ(ldm("__XMJYAUZ___"s, "___MZJAWXU___-"s), 7U);
+  TLO_EXPECT_EQ(ldm("0123456789"s, "0123456789"s), 0U);
+  TLO_EXPECT_EQ(ldm("01234567"s, "abcdefghij"s), 10U);
+  TLO_EXPECT_EQ(ldm("aaabbb"s, "aaabbb___bbbccc"s), 9U);
+  TLO_EXPECT_EQ(ldm("bbbccc"s, "aaabbb___bbbccc"s), 9U);
+  TLO_EXPECT_EQ(ldm("aaabbbccc"s, "aaabbb___bbbccc"s), 6U);
+  TLO_EXPECT_EQ(ldm("sitting"s, "kitten"s), 3U);
+  TLO_EXPECT_EQ(ldm("Sunday"s, "Saturday"s), 3U);
+  TLO_EXPECT_EQ(ldm("CA"s, "ABC"s), 3U);
+}
+
+TLO_TEST(levenshteinDistanceMyers_long_sequences) {
+  for (std::size_t size1 : {1U, 63U, 64U, 65U, 127U, 128U, 129U, 300U}) {
+    for (std::size_t size2 : {1U, 64U, 65U, 200U}) {
+      for (std::size_t alphabetSize : {2U, 4U, 26U}) {
+        std::string string1 = makeString(size1, alphabetSize, 1);
+        std::string string2 = makeString(size2, alphabetSize, 2);
+
+        TLO_EXPECT_EQ(tlo::levenshteinDistanceMyers(string1, string2),
+                      tlo::levenshteinDistance2(string1, string2));
+      }
+    }
+  }
+}
+
+TLO_TEST(levenshteinDistanceMyers_wide_elements) {
+  using Ints = std::vector<int>;
+
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceMyers(Ints{1000, 2000, 3000},
+                                              Ints{2000, 3000, 4000}),
+                2U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistanceMyers(Ints{-1, 256, 512, 7},
+                                              Ints{7, 256, -1}),
+                3U);
+}
+
+TLO_TEST(levenshteinDistanceSimd) {
+  const auto &lds = tlo::levenshteinDistanceSimd<std::string>;
+
+  TLO_EXPECT_EQ(lds(""s, ""s), 0U);
+  TLO_EXPECT_EQ(lds("GAC"s, ""s), 3U);
+  TLO_EXPECT_EQ(lds(""s, "AGCAT"s), 5U);
+  TLO_EXPECT_EQ(lds("GAC"s, "AGCAT"s), 3U);
+  TLO_EXPECT_EQ(lds("XMJYAUZ"s, "MZJAWXU"s), 6U);
+  TLO_EXPECT_EQ(lds("___XMJYAUZ___"s, "__MZJAWXU___"s), 7U);
+  TLO_EXPECT_EQ(lds("__XMJYAUZ___"s, "___MZJAWXU___-"s), 7U);
+  TLO_EXPECT_EQ(lds("0123456789"s, "0123456789"s), 0U);
+  TLO_EXPECT_EQ(lds("01234567"s, "abcdefghij"s), 10U);
+  TLO_EXPECT_EQ(lds("aaabbb"s, "aaabbb___bbbccc"s), 9U);
+  TLO_EXPECT_EQ(lds("bbbccc"s, "aaabbb___bbbccc"s), 9U);
+  TLO_EXPECT_EQ(lds("aaabbbccc"s, "aaabbb___bbbccc"s), 6U);
+  TLO_EXPECT_EQ(lds("sitting"s, "kitten"s), 3U);
+  TLO_EXPECT_EQ(lds("Sunday"s, "Saturday"s), 3U);
+  TLO_EXPECT_EQ(lds("CA"s, "ABC"s), 3U);
+  TLO_EXPECT_EQ(lds(makeString(300, 4, 8), makeString(280, 4, 9)),
+                tlo::levenshteinDistance2(makeString(300, 4, 8),
+                                          makeString(280, 4, 9)));
+}
+
+TLO_TEST(levenshteinDistanceBatch) {
+  const std::string query = "kitten"s;
+  const std::vector<std::string> candidates = {
+      ""s, "sitting"s, "kitten"s, "mitten"s, "kit"s, "Saturday"s,
+      makeString(100, 4, 5), makeString(200, 26, 6)};
+  std::vector<std::size_t> distances(candidates.size());
+
+  auto end =
+      tlo::levenshteinDistanceBatch(query, candidates, distances.begin());
+
+  TLO_EXPECT(end == distances.end());
+
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    TLO_EXPECT_EQ(distances[i],
+                  tlo::levenshteinDistance2(query, candidates[i]));
+  }
+
+  const std::string longQuery = makeString(150, 4, 7);
+
+  tlo::levenshteinDistanceBatch(longQuery, candidates, distances.begin());
+
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    TLO_EXPECT_EQ(distances[i],
+                  tlo::levenshteinDistance2(longQuery, candidates[i]));
+  }
+
+  tlo::levenshteinDistanceBatch(""s, candidates, distances.begin());
+
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    TLO_EXPECT_EQ(distances[i], candidates[i].size());
+  }
+}
+
+TLO_TEST(nearestByLevenshtein) {
+  using Nearest = std::vector<std::pair<std::size_t, std::size_t>>;
+
+  const std::vector<std::string> words = {"kitten"s, "sitting"s, "mitten"s,
+                                          "kitchen"s, "kitten"s, "bitten"s,
+                                          ""s};
+
+  TLO_EXPECT(tlo::nearestByLevenshtein("kitten"s, words, 0) == Nearest());
+  TLO_EXPECT(tlo::nearestByLevenshtein("kitten"s, words, 1) ==
+             Nearest({{0, 0}}));
+  TLO_EXPECT(tlo::nearestByLevenshtein("kitten"s, words, 3) ==
+             Nearest({{0, 0}, {4, 0}, {2, 1}}));
+  TLO_EXPECT(tlo::nearestByLevenshtein("kitten"s, words, 100) ==
+             Nearest({{0, 0},
+                      {4, 0},
+                      {2, 1},
+                      {5, 1},
+                      {3, 2},
+                      {1, 3},
+                      {6, 6}}));
+  TLO_EXPECT(tlo::nearestByLevenshtein("kitten"s, std::vector<std::string>(),
+                                       3) == Nearest());
+
+  std::vector<std::string> candidates;
+
+  for (unsigned seed = 0; seed < 300; ++seed) {
+    candidates.push_back(makeString(seed % 20, 4, seed));
+  }
+
+  for (unsigned seed = 0; seed < 10; ++seed) {
+    std::string query = makeString(5 + seed, 4, seed + 1000);
+    Nearest expected;
+
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+      expected.emplace_back(i, tlo::levenshteinDistance2(query, candidates[i]));
+    }
+
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const auto &pair1, const auto &pair2) {
+                       return pair1.second < pair2.second;
+                     });
+
+    for (std::size_t k : {1U, 5U, 17U}) {
+      Nearest top(expected.begin(),
+                  expected.begin() + static_cast<std::ptrdiff_t>(k));
+
+      TLO_EXPECT(tlo::nearestByLevenshtein(query, candidates, k) == top);
+    }
+  }
+}
+
 TLO_TEST(levenshteinDistance3_with_levenshteinDistance1) {
   const auto &ld1_ = tlo::levenshteinDistance1_<std::string>;
 
@@ -94,4 +504,58 @@ TLO_TEST(levenshteinDistance3_with_levenshteinDistance2) {
   TLO_EXPECT_EQ(tlo::levenshteinDistance3("Sunday"s, "Saturday"s), 3U);
   TLO_EXPECT_EQ(tlo::levenshteinDistance3("CA"s, "ABC"s), 3U);
 }
+
+TLO_TEST(levenshteinDistance3_with_levenshteinDistanceMyers) {
+  const auto &ldm_ = tlo::levenshteinDistanceMyers_<std::string>;
+
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3(""s, ""s, ldm_), 0U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("GAC"s, ""s, ldm_), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3(""s, "AGCAT"s, ldm_), 5U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("GAC"s, "AGCAT"s, ldm_), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("XMJYAUZ"s, "MZJAWXU"s, ldm_), 6U);
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistance3("___XMJYAUZ___"s, "__MZJAWXU___"s, ldm_), 7U);
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistance3("__XMJYAUZ___"s, "___MZJAWXU___-"s, ldm_), 7U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("0123456789"s, "0123456789"s, ldm_),
+                0U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("01234567"s, "abcdefghij"s, ldm_),
+                10U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("aaabbb"s, "aaabbb___bbbccc"s, ldm_),
+                9U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("bbbccc"s, "aaabbb___bbbccc"s, ldm_),
+                9U);
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistance3("aaabbbccc"s, "aaabbb___bbbccc"s, ldm_), 6U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("sitting"s, "kitten"s, ldm_), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("Sunday"s, "Saturday"s, ldm_), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("CA"s, "ABC"s, ldm_), 3U);
+}
+
+TLO_TEST(levenshteinDistance3_with_levenshteinDistanceWavefront) {
+  const auto &ldw_ = tlo::levenshteinDistanceWavefront_<std::string>;
+
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3(""s, ""s, ldw_), 0U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("GAC"s, ""s, ldw_), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3(""s, "AGCAT"s, ldw_), 5U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("GAC"s, "AGCAT"s, ldw_), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("XMJYAUZ"s, "MZJAWXU"s, ldw_), 6U);
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistance3("___XMJYAUZ___"s, "__MZJAWXU___"s, ldw_), 7U);
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistance3("__XMJYAUZ___"s, "___MZJAWXU___-"s, ldw_), 7U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("0123456789"s, "0123456789"s, ldw_),
+                0U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("01234567"s, "abcdefghij"s, ldw_),
+                10U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("aaabbb"s, "aaabbb___bbbccc"s, ldw_),
+                9U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("bbbccc"s, "aaabbb___bbbccc"s, ldw_),
+                9U);
+  TLO_EXPECT_EQ(
+      tlo::levenshteinDistance3("aaabbbccc"s, "aaabbb___bbbccc"s, ldw_), 6U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("sitting"s, "kitten"s, ldw_), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("Sunday"s, "Saturday"s, ldw_), 3U);
+  TLO_EXPECT_EQ(tlo::levenshteinDistance3("CA"s, "ABC"s, ldw_), 3U);
+}
 }  // namespace
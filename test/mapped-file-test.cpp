@@ -0,0 +1,129 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tlo-cpp/damerau-levenshtein.hpp>
+#include <tlo-cpp/filesystem.hpp>
+#include <tlo-cpp/lcs.hpp>
+#include <tlo-cpp/levenshtein.hpp>
+#include <tlo-cpp/mapped-file.hpp>
+#include <tlo-cpp/test.hpp>
+#include <utility>
+
+#include "random-strings.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+using namespace std::string_literals;
+
+using tlo::test::makeString;
+
+// Writes contents to a file in the temporary directory and removes the file
+// when destroyed.
+class TempFile {
+ private:
+  fs::path path_;
+
+ public:
+  TempFile(const std::string &name, const std::string &contents)
+      : path_(fs::temp_directory_path() / ("tlo-cpp-" + name)) {
+    std::ofstream ofstream(path_, std::ofstream::out | std::ofstream::binary);
+
+    ofstream << contents;
+  }
+
+  TempFile(const TempFile &) = delete;
+  ~TempFile() { fs::remove(path_); }
+
+  TempFile &operator=(const TempFile &) = delete;
+
+  const fs::path &path() const { return path_; }
+};
+
+TLO_TEST(MappedFileDefaultConstructor) {
+  tlo::MappedFile mappedFile;
+
+  TLO_EXPECT_FALSE(mappedFile.isOpen());
+  TLO_EXPECT_EQ(mappedFile.size(), 0U);
+}
+
+TLO_TEST(MappedFileOpen) {
+  const auto contents = "sitting\nkitten\n"s;
+  TempFile file("mapped-file-open", contents);
+  TempFile emptyFile("mapped-file-open-empty", "");
+  tlo::MappedFile mappedFile(file.path());
+  tlo::MappedFile emptyMappedFile(emptyFile.path());
+
+  TLO_ASSERT(mappedFile.isOpen());
+  TLO_ASSERT_EQ(mappedFile.size(), contents.size());
+  TLO_EXPECT_EQ(std::string(mappedFile.begin(), mappedFile.end()), contents);
+  TLO_EXPECT_EQ(mappedFile[7], '\n');
+  TLO_EXPECT(emptyMappedFile.isOpen());
+  TLO_EXPECT_EQ(emptyMappedFile.size(), 0U);
+
+  tlo::MappedFile movedMappedFile(std::move(mappedFile));
+
+  TLO_EXPECT_FALSE(mappedFile.isOpen());
+  TLO_EXPECT(movedMappedFile.isOpen());
+  TLO_EXPECT_EQ(movedMappedFile.size(), contents.size());
+
+  bool threw = false;
+
+  try {
+    tlo::MappedFile missing(fs::temp_directory_path() /
+                            "tlo-cpp-mapped-file-missing");
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+
+  TLO_EXPECT(threw);
+}
+
+TLO_TEST(MappedFile_distances) {
+  const auto string1 = makeString(5000, 4, 1U);
+  auto string2 = string1;
+
+  string2.erase(1000, 300);
+  string2.insert(3000, makeString(200, 4, 2U));
+  string2[4000] = 'z';
+
+  TempFile file1("mapped-file-distances-1", string1);
+  TempFile file2("mapped-file-distances-2", string2);
+  tlo::MappedFile mappedFile1(file1.path());
+  tlo::MappedFile mappedFile2(file2.path());
+
+  TLO_EXPECT_EQ(tlo::lcsLength3(mappedFile1, mappedFile2),
+                tlo::lcsLength3(string1, string2));
+  TLO_EXPECT_EQ(tlo::levenshteinDistance2(mappedFile1, mappedFile2),
+                tlo::levenshteinDistance2(string1, string2));
+  TLO_EXPECT_EQ(tlo::damerLevenDistance2(mappedFile1, mappedFile2),
+                tlo::damerLevenDistance2(string1, string2));
+}
+
+TLO_TEST(forEachChunk_with_row_streams) {
+  const auto string1 = makeString(3000, 4, 3U);
+  const auto string2 = makeString(400, 4, 4U);
+  TempFile file2("mapped-file-row-streams", string2);
+  tlo::MappedFile mappedFile2(file2.path());
+  tlo::LevenshteinRowStream<tlo::MappedFile> levenshteinRowStream(mappedFile2);
+  tlo::LcsRowStream<tlo::MappedFile> lcsRowStream(mappedFile2);
+  std::istringstream istream(string1);
+  std::size_t numChunks = 0;
+
+  tlo::forEachChunk(istream, 256,
+                    [&](const char *chunk, std::size_t chunkSize) {
+                      levenshteinRowStream.push(chunk, chunk + chunkSize);
+                      lcsRowStream.push(chunk, chunk + chunkSize);
+                      ++numChunks;
+                    });
+
+  TLO_EXPECT_EQ(numChunks, 12U);
+  TLO_EXPECT_EQ(levenshteinRowStream.size1(), string1.size());
+  TLO_EXPECT_EQ(levenshteinRowStream.distance(),
+                tlo::levenshteinDistance2(string1, string2));
+  TLO_EXPECT_EQ(lcsRowStream.result(), tlo::lcsLength2(string1, string2));
+}
+}  // namespace
@@ -0,0 +1,38 @@
+#include <atomic>
+#include <stdexcept>
+#include <tlo-cpp/parallel.hpp>
+#include <tlo-cpp/test.hpp>
+#include <vector>
+
+namespace {
+TLO_TEST(parallelFor) {
+  for (std::size_t numThreads : {0U, 1U, 2U, 3U, 8U}) {
+    for (std::size_t numTasks : {0U, 1U, 5U, 1000U}) {
+      std::vector<std::atomic<int>> calls(numTasks);
+
+      tlo::parallelFor(numTasks, numThreads,
+                       [&](std::size_t task) { calls[task]++; });
+
+      for (std::size_t i = 0; i < numTasks; ++i) {
+        TLO_EXPECT_EQ(calls[i].load(), 1);
+      }
+    }
+  }
+}
+
+TLO_TEST(parallelFor_exception) {
+  bool caught = false;
+
+  try {
+    tlo::parallelFor(100, 4, [](std::size_t task) {
+      if (task == 42) {
+        throw std::runtime_error("task 42");
+      }
+    });
+  } catch (const std::runtime_error &) {
+    caught = true;
+  }
+
+  TLO_EXPECT(caught);
+}
+}  // namespace
@@ -0,0 +1,81 @@
+#include <cstddef>
+#include <string>
+#include <tlo-cpp/levenshtein.hpp>
+#include <tlo-cpp/q-gram.hpp>
+#include <tlo-cpp/test.hpp>
+#include <utility>
+#include <vector>
+
+#include "random-strings.hpp"
+
+namespace {
+using namespace std::string_literals;
+
+using tlo::test::makeString;
+
+using Ids = std::vector<std::size_t>;
+using Matches = std::vector<std::pair<std::size_t, std::size_t>>;
+
+TLO_TEST(QGramIndex) {
+  std::vector<std::string> corpus = {"kitten"s, "sitting"s, "mitten"s,
+                                     "kitchen"s, "ab"s, ""s, "written"s};
+  tlo::QGramIndex<std::string> index(2);
+
+  for (const std::string &sequence : corpus) {
+    index.add(sequence);
+  }
+
+  TLO_EXPECT_EQ(index.q(), 2U);
+  TLO_EXPECT_EQ(index.size(), 7U);
+  TLO_EXPECT(index.candidates("kitten"s, 0) == Ids({0}));
+  TLO_EXPECT(index.candidates("kitten"s, 1) == Ids({0, 2, 6}));
+  TLO_EXPECT(index.candidates("b"s, 1) == Ids({4, 5}));
+  TLO_EXPECT(tlo::levenshteinSearch(index, corpus, "kitten"s, 1) ==
+             Matches({{0, 0}, {2, 1}}));
+  TLO_EXPECT(tlo::levenshteinSearch(index, corpus, "kitten"s, 2) ==
+             Matches({{0, 0}, {2, 1}, {3, 2}, {6, 2}}));
+}
+
+TLO_TEST(QGramIndex_matches_linear_scan) {
+  std::vector<std::string> corpus;
+
+  for (unsigned seed = 0; seed < 400; ++seed) {
+    std::string sequence = makeString(4 + seed % 12, 6, seed);
+
+    corpus.push_back(sequence);
+
+    if (seed % 4 == 0 && sequence.size() > 2) {
+      sequence[seed % sequence.size()] = 'z';
+      sequence.erase(1, 1);
+      corpus.push_back(sequence);
+    }
+  }
+
+  for (std::size_t q = 1; q <= 3; ++q) {
+    tlo::QGramIndex<std::string> index(q);
+
+    for (const std::string &sequence : corpus) {
+      index.add(sequence);
+    }
+
+    for (unsigned seed = 0; seed < 400; seed += 13) {
+      const std::string &query = corpus[seed];
+
+      for (std::size_t maxDistance = 0; maxDistance <= 3; ++maxDistance) {
+        Matches expected;
+
+        for (std::size_t id = 0; id < corpus.size(); ++id) {
+          std::size_t distance = tlo::levenshteinDistance2(query, corpus[id]);
+
+          if (distance <= maxDistance) {
+            expected.emplace_back(id, distance);
+          }
+        }
+
+        TLO_EXPECT(tlo::levenshteinSearch(index, corpus, query, maxDistance) ==
+                   expected);
+      }
+    }
+  }
+}
+}  // namespace
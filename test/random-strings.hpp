@@ -0,0 +1,25 @@
+#ifndef TLO_CPP_TEST_RANDOM_STRINGS_HPP
+#define TLO_CPP_TEST_RANDOM_STRINGS_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace tlo {
+namespace test {
+// Returns a deterministic pseudo-random string of given size over the first
+// alphabetSize lowercase letters.
+inline std::string makeString(std::size_t size, std::size_t alphabetSize,
+                              unsigned seed) {
+  std::string string;
+
+  for (std::size_t i = 0; i < size; ++i) {
+    seed = seed * 1103515245U + 12345U;
+    string.push_back(static_cast<char>('a' + (seed >> 16) % alphabetSize));
+  }
+
+  return string;
+}
+}  // namespace test
+}  // namespace tlo
+
+#endif  // TLO_CPP_TEST_RANDOM_STRINGS_HPP
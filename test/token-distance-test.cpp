@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <string>
+#include <tlo-cpp/lcs.hpp>
+#include <tlo-cpp/test.hpp>
+#include <tlo-cpp/token-distance.hpp>
+#include <vector>
+
+namespace {
+using namespace std::string_literals;
+using Ids = std::vector<std::uint64_t>;
+
+TLO_TEST(TokenInterner) {
+  tlo::TokenInterner interner(8);
+
+  TLO_EXPECT_EQ(interner.intern("alpha"), 0U);
+  TLO_EXPECT_EQ(interner.intern("beta"), 1U);
+  TLO_EXPECT_EQ(interner.intern("alpha"), 0U);
+  TLO_EXPECT_EQ(interner.intern(""), 2U);
+  TLO_EXPECT_EQ(interner.intern("a token longer than a block"), 3U);
+  TLO_EXPECT_EQ(interner.intern("gamma"), 4U);
+  TLO_EXPECT_EQ(interner.size(), 5U);
+  TLO_EXPECT_EQ(interner.token(0), "alpha");
+  TLO_EXPECT_EQ(interner.token(3), "a token longer than a block");
+  TLO_EXPECT_EQ(interner.token(4), "gamma");
+
+  for (int i = 0; i < 1000; ++i) {
+    interner.intern(std::to_string(i));
+  }
+
+  TLO_EXPECT_EQ(interner.size(), 1005U);
+  TLO_EXPECT_EQ(interner.intern("beta"), 1U);
+  TLO_EXPECT_EQ(interner.intern("999"), 1004U);
+  TLO_EXPECT_EQ(interner.token(1004), "999");
+}
+
+TLO_TEST(TokenInterner_tokenize) {
+  tlo::TokenInterner interner;
+
+  const auto lines = tlo::TokenGranularity::LINES;
+  const auto words = tlo::TokenGranularity::WORDS;
+
+  TLO_EXPECT(interner.tokenize(""s, lines) == Ids());
+  TLO_EXPECT(interner.tokenize("a b\r\n\nc\n"s, lines) == Ids({0, 1, 2}));
+  TLO_EXPECT(interner.tokenize("c\na b"s, lines) == Ids({2, 0}));
+  TLO_EXPECT(interner.tokenize("  a\tb\n\n c  "s, words) == Ids({3, 4, 2}));
+  TLO_EXPECT(interner.tokenize(" \n\t "s, words) == Ids());
+}
+
+TLO_TEST(tokenLevenshteinDistance) {
+  const auto document1 = "int main() {\n  return 0;\n}\n"s;
+  const auto document2 =
+      "#include <cstdio>\nint main() {\n  puts(\"hi\");\n  return 0;\n}\n"s;
+  const auto document3 = "int main() {\n  return 1;\n}\n"s;
+  tlo::TokenInterner interner;
+
+  TLO_EXPECT_EQ(tlo::tokenLevenshteinDistance(document1, document2,
+                                              tlo::TokenGranularity::LINES,
+                                              interner),
+                2U);
+  TLO_EXPECT_EQ(tlo::tokenLevenshteinDistance(document1, document3,
+                                              tlo::TokenGranularity::LINES,
+                                              interner),
+                1U);
+  TLO_EXPECT_EQ(tlo::tokenLevenshteinDistance(document1, document1,
+                                              tlo::TokenGranularity::LINES),
+                0U);
+  TLO_EXPECT_EQ(tlo::tokenLevenshteinDistance("the quick brown fox"s,
+                                              "the  quick\tred fox jumps"s,
+                                              tlo::TokenGranularity::WORDS),
+                2U);
+  TLO_EXPECT_EQ(tlo::tokenLevenshteinDistance(""s, "a\nb\n"s,
+                                              tlo::TokenGranularity::LINES),
+                2U);
+}
+
+TLO_TEST(tokenLcsLength) {
+  const auto document1 = "int main() {\n  return 0;\n}\n"s;
+  const auto document2 =
+      "#include <cstdio>\nint main() {\n  puts(\"hi\");\n  return 0;\n}\n"s;
+  const auto document3 = "int main() {\n  return 1;\n}\n"s;
+  tlo::TokenInterner interner;
+
+  TLO_EXPECT_EQ(tlo::tokenLcsLength(document1, document2,
+                                    tlo::TokenGranularity::LINES, interner),
+                (tlo::LcsLengthResult{3, 2}));
+  TLO_EXPECT_EQ(tlo::tokenLcsLength(document1, document3,
+                                    tlo::TokenGranularity::LINES, interner),
+                (tlo::LcsLengthResult{2, 2}));
+  TLO_EXPECT_EQ(tlo::tokenLcsLength("the quick brown fox"s,
+                                    "the  quick\tred fox jumps"s,
+                                    tlo::TokenGranularity::WORDS),
+                (tlo::LcsLengthResult{3, 3}));
+}
+}  // namespace
@@ -0,0 +1,204 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tlo-cpp/lcs.hpp>
+#include <tlo-cpp/levenshtein.hpp>
+#include <tlo-cpp/test.hpp>
+#include <tlo-cpp/utf8.hpp>
+#include <type_traits>
+#include <vector>
+
+namespace {
+using namespace std::string_literals;
+
+// Returns 0 if the units of text1 and text2 are passed as the texts
+// themselves, and otherwise the size of the units they are decoded into.
+std::size_t unitSize(const std::string &text1, const std::string &text2,
+                     tlo::Utf8Unit unit = tlo::Utf8Unit::CODE_POINTS) {
+  return tlo::withUtf8Units(
+      text1, text2, unit, [](const auto &sequence1, const auto &) {
+        using Sequence = std::decay_t<decltype(sequence1)>;
+
+        if constexpr (std::is_same_v<Sequence, std::string_view>) {
+          return std::size_t{0};
+        } else {
+          return sizeof(sequence1[0]);
+        }
+      });
+}
+
+TLO_TEST(isAscii) {
+  TLO_EXPECT(tlo::isAscii(""));
+  TLO_EXPECT(tlo::isAscii("kitten"));
+  TLO_EXPECT(tlo::isAscii(std::string(100, 'a')));
+
+  for (std::size_t index : {0U, 7U, 8U, 15U, 16U, 99U}) {
+    std::string text(100, 'a');
+
+    text[index] = '\x80';
+    TLO_EXPECT_FALSE(tlo::isAscii(text));
+  }
+}
+
+TLO_TEST(decodeUtf8) {
+  tlo::internal::Utf8CodePoints codePoints;
+
+  tlo::internal::decodeUtf8(u8"a\u00E9", codePoints);
+  TLO_EXPECT_EQ(codePoints.unitSize, 1U);
+  TLO_EXPECT(codePoints.units8 == (std::vector<std::uint8_t>{'a', 0xE9}));
+
+  tlo::internal::decodeUtf8(u8"\u4EAC", codePoints);
+  TLO_EXPECT_EQ(codePoints.unitSize, 2U);
+  TLO_EXPECT(codePoints.units8.empty());
+  TLO_EXPECT(codePoints.units16 == (std::vector<char16_t>{u'a', 0xE9, 0x4EAC}));
+
+  tlo::internal::decodeUtf8(u8"b\U0001F600", codePoints);
+  TLO_EXPECT_EQ(codePoints.unitSize, 4U);
+  TLO_EXPECT(codePoints.units16.empty());
+  TLO_EXPECT(codePoints.units32 ==
+             (std::vector<char32_t>{U'a', 0xE9, 0x4EAC, U'b', 0x1F600}));
+
+  // Widens from one byte straight to four.
+  codePoints = tlo::internal::Utf8CodePoints();
+  tlo::internal::decodeUtf8(u8"\u00E9\U0001F600\u4EAC", codePoints);
+  TLO_EXPECT_EQ(codePoints.unitSize, 4U);
+  TLO_EXPECT(codePoints.units32 ==
+             (std::vector<char32_t>{0xE9, 0x1F600, 0x4EAC}));
+
+  // A truncated sequence, an overlong encoding, an encoded surrogate, and a
+  // code point above 0x10FFFF.
+  codePoints = tlo::internal::Utf8CodePoints();
+  tlo::internal::decodeUtf8("\xC3", codePoints);
+  tlo::internal::decodeUtf8("\xC0\xAF", codePoints);
+  tlo::internal::decodeUtf8("\xED\xA0\x80", codePoints);
+  tlo::internal::decodeUtf8("\xF4\x90\x80\x80", codePoints);
+  TLO_EXPECT_EQ(codePoints.unitSize, 2U);
+  TLO_EXPECT(codePoints.units16 ==
+             (std::vector<char16_t>{0xDCC3, 0xDCC0, 0xDCAF, 0xDCED, 0xDCA0,
+                                    0xDC80, 0xDCF4, 0xDC90, 0xDC80, 0xDC80}));
+}
+
+TLO_TEST(withUtf8Units) {
+  TLO_EXPECT_EQ(unitSize("Jose"s, "Joseph"s), 0U);
+  TLO_EXPECT_EQ(unitSize(u8"Jos\u00E9"s, "Jose"s), 1U);
+  TLO_EXPECT_EQ(unitSize(u8"\u0141ukasz"s, "Lukasz"s), 2U);
+  TLO_EXPECT_EQ(unitSize("\xFF"s, "y"s), 2U);
+  TLO_EXPECT_EQ(unitSize(u8"\U0001F600"s, "Lukasz"s), 4U);
+  TLO_EXPECT_EQ(unitSize("a\r\nb"s, "a"s), 0U);
+  TLO_EXPECT_EQ(unitSize("a\r\nb"s, "a"s, tlo::Utf8Unit::GRAPHEME_CLUSTERS),
+                4U);
+  TLO_EXPECT_EQ(
+      unitSize("a\n\rb"s, "a"s, tlo::Utf8Unit::GRAPHEME_CLUSTERS), 0U);
+}
+
+TLO_TEST(utf8LevenshteinDistance) {
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance("", ""), 0U);
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance("sitting", "kitten"), 3U);
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance(u8"Jos\u00E9", "Jose"), 1U);
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance(u8"M\u00FCller", "Mueller"),
+                2U);
+  TLO_EXPECT_EQ(
+      tlo::utf8LevenshteinDistance(u8"\u5317\u4EAC", u8"\u6771\u4EAC"), 1U);
+  TLO_EXPECT_EQ(
+      tlo::utf8LevenshteinDistance(u8"a\U0001F600b", u8"a\U0001F601b"), 1U);
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance("\xC3", "\xC4"), 1U);
+}
+
+TLO_TEST(utf8LevenshteinDistance_grapheme_clusters) {
+  const auto CLUSTERS = tlo::Utf8Unit::GRAPHEME_CLUSTERS;
+
+  // "e" with a combining acute accent against a precomposed one.
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance(u8"Noe\u0301l", u8"No\u00EBl"),
+                2U);
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance(u8"Noe\u0301l", u8"No\u00EBl",
+                                             CLUSTERS),
+                1U);
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance(u8"Noe\u0301l", u8"Noa\u0301l",
+                                             CLUSTERS),
+                1U);
+
+  // Hangul jamo against the precomposed syllable.
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance(u8"\u1100\u1161", u8"\uAC00"),
+                2U);
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance(u8"\u1100\u1161", u8"\uAC00",
+                                             CLUSTERS),
+                1U);
+
+  // Flags of France and Germany, and a family emoji joined by ZWJs.
+  const std::string france = u8"\U0001F1EB\U0001F1F7";
+  const std::string germany = u8"\U0001F1E9\U0001F1EA";
+  const std::string family =
+      u8"\U0001F468\u200D\U0001F469\u200D\U0001F467";
+
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance(france + germany,
+                                             germany + france, CLUSTERS),
+                2U);
+  TLO_EXPECT_EQ(
+      tlo::utf8LevenshteinDistance("a" + family + "b", "ab", CLUSTERS), 1U);
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance("a\r\nb", "a\nb", CLUSTERS), 1U);
+  TLO_EXPECT_EQ(tlo::utf8LevenshteinDistance("a\n\rb", "a\nb", CLUSTERS), 1U);
+}
+
+TLO_TEST(utf8DamerLevenDistance) {
+  const auto CLUSTERS = tlo::Utf8Unit::GRAPHEME_CLUSTERS;
+  const std::string france = u8"\U0001F1EB\U0001F1F7";
+  const std::string germany = u8"\U0001F1E9\U0001F1EA";
+
+  TLO_EXPECT_EQ(tlo::utf8DamerLevenDistance("CA", "ABC"), 2U);
+  TLO_EXPECT_EQ(tlo::utf8DamerLevenDistance(u8"Zo\u00EB", u8"Z\u00EBo"), 1U);
+  TLO_EXPECT_EQ(tlo::utf8DamerLevenDistance(france + germany,
+                                            germany + france, CLUSTERS),
+                1U);
+}
+
+TLO_TEST(utf8LcsLength) {
+  TLO_EXPECT_EQ(tlo::utf8LcsLength("sitting", "kitten").lcsLength, 4U);
+  const auto angstrom = tlo::utf8LcsLength(u8"\u00C5ngstr\u00F6m", "Angstrom");
+
+  TLO_EXPECT_EQ(angstrom.lcsLength, 6U);
+  TLO_EXPECT_EQ(angstrom.lcsDistance, 4U);
+  TLO_EXPECT_EQ(
+      tlo::utf8LcsLength(u8"Noe\u0301l", u8"No\u00EBl",
+                         tlo::Utf8Unit::GRAPHEME_CLUSTERS)
+          .lcsDistance,
+      2U);
+}
+
+TLO_TEST(utf8LevenshteinDistance_with_code_point_vectors) {
+  const std::string pieces[] = {"a",      "b",         u8"\u00E9",
+                                u8"\u00DF", "\xC3",      u8"\u4EAC",
+                                u8"\U0001F600"};
+  unsigned seed = 1;
+
+  const auto makeText = [&](std::size_t numPieces, std::size_t numKinds) {
+    std::string text;
+
+    for (std::size_t i = 0; i < numPieces; ++i) {
+      seed = seed * 1103515245U + 12345U;
+      text += pieces[(seed >> 16) % numKinds];
+    }
+
+    return text;
+  };
+
+  for (std::size_t numKinds = 2; numKinds <= 7; ++numKinds) {
+    for (std::size_t i = 0; i < 20; ++i) {
+      const auto text1 = makeText(i, numKinds);
+      const auto text2 = makeText(20 - i, numKinds);
+      tlo::internal::Utf8CodePoints codePoints1;
+      tlo::internal::Utf8CodePoints codePoints2;
+
+      tlo::internal::widenUtf8CodePoints(codePoints1, 4);
+      tlo::internal::widenUtf8CodePoints(codePoints2, 4);
+      tlo::internal::decodeUtf8(text1, codePoints1);
+      tlo::internal::decodeUtf8(text2, codePoints2);
+      TLO_EXPECT_EQ(
+          tlo::utf8LevenshteinDistance(text1, text2),
+          tlo::levenshteinDistance2(codePoints1.units32, codePoints2.units32));
+      TLO_EXPECT_EQ(tlo::utf8LcsLength(text1, text2),
+                    tlo::lcsLength2(codePoints1.units32, codePoints2.units32));
+    }
+  }
+}
+}  // namespace